@@ -33,6 +33,7 @@ HEADERS += ext/joyent-http-parser/http_parser.h \
            src/Anonymity/ShuffleBlamer.hpp \
            src/Anonymity/ShuffleRound.hpp \
            src/Anonymity/ShuffleRoundBlame.hpp \
+           src/Anonymity/SubmissionDeadline.hpp \
            src/Anonymity/Tolerant/Accusation.hpp \
            src/Anonymity/Tolerant/AlibiData.hpp \
            src/Anonymity/Tolerant/BlameMatrix.hpp \
@@ -67,27 +68,45 @@ HEADERS += ext/joyent-http-parser/http_parser.h \
            src/Connections/RelayEdgeListener.hpp \
            src/Connections/RelayForwarder.hpp \
            src/Crypto/AsymmetricKey.hpp \
+           src/Crypto/BatchVerifier.hpp \
+           src/Crypto/CppBlake2bHash.hpp \
            src/Crypto/CppDiffieHellman.hpp \
            src/Crypto/CppDsaPrivateKey.hpp \
            src/Crypto/CppDsaPublicKey.hpp \
+           src/Crypto/CppEcDiffieHellman.hpp \
+           src/Crypto/CppEcGroup.hpp \
+           src/Crypto/CppEcLibrary.hpp \
+           src/Crypto/CppEcPrivateKey.hpp \
+           src/Crypto/CppEcPublicKey.hpp \
+           src/Crypto/CppFixedBaseCache.hpp \
+           src/Crypto/CppFixedBaseTable.hpp \
            src/Crypto/CppHash.hpp \
+           src/Crypto/CppInteger.hpp \
            src/Crypto/CppIntegerData.hpp \
+           src/Crypto/CppKeystreamGenerator.hpp \
            src/Crypto/CppLibrary.hpp \
            src/Crypto/CppPrivateKey.hpp \
            src/Crypto/CppPublicKey.hpp \
            src/Crypto/CppRandom.hpp \
+           src/Crypto/CppSha256Hash.hpp \
            src/Crypto/CryptoFactory.hpp \
            src/Crypto/DiffieHellman.hpp \
            src/Crypto/NullDiffieHellman.hpp \
            src/Crypto/Hash.hpp \
            src/Crypto/Integer.hpp \
            src/Crypto/IntegerData.hpp \
+           src/Crypto/KeystreamGenerator.hpp \
            src/Crypto/NullHash.hpp \
+           src/Crypto/NullKeystreamGenerator.hpp \
            src/Crypto/NullLibrary.hpp \
            src/Crypto/NullPublicKey.hpp \
            src/Crypto/NullPrivateKey.hpp \
            src/Crypto/Library.hpp \
            src/Crypto/OnionEncryptor.hpp \
+           src/Crypto/PadCache.hpp \
+           src/Crypto/PadGenerator.hpp \
+           src/Crypto/SharedSecretCache.hpp \
+           src/Crypto/SlotRandomizer.hpp \
            src/Crypto/ThreadedOnionEncryptor.hpp \
            src/Crypto/Serialization.hpp \
            src/Identity/Authentication/IAuthenticate.hpp \
@@ -161,6 +180,7 @@ HEADERS += ext/joyent-http-parser/http_parser.h \
            src/Utils/Sleeper.hpp \
            src/Utils/StartStop.hpp \
            src/Utils/StartStopSlots.hpp \
+           src/Utils/TaskScheduler.hpp \
            src/Utils/Time.hpp \
            src/Utils/Timer.hpp \
            src/Utils/TimerCallback.hpp \
@@ -168,6 +188,8 @@ HEADERS += ext/joyent-http-parser/http_parser.h \
            src/Utils/Triggerable.hpp \
            src/Utils/Triple.hpp \
            src/Utils/Utils.hpp \
+           src/Utils/XorKernel.hpp \
+           src/Utils/ZeroRunLength.hpp \
            src/Web/HttpRequest.hpp \
            src/Web/HttpResponse.hpp \
            src/Web/WebRequest.hpp \
@@ -201,6 +223,7 @@ SOURCES += ext/joyent-http-parser/http_parser.c \
            src/Anonymity/ShuffleBlamer.cpp \
            src/Anonymity/ShuffleRound.cpp \
            src/Anonymity/ShuffleRoundBlame.cpp \
+           src/Anonymity/SubmissionDeadline.cpp \
            src/Anonymity/Tolerant/Accusation.cpp \
            src/Anonymity/Tolerant/AlibiData.cpp \
            src/Anonymity/Tolerant/BlameMatrix.cpp \
@@ -228,20 +251,35 @@ SOURCES += ext/joyent-http-parser/http_parser.c \
            src/Connections/RelayEdgeListener.cpp \
            src/Connections/RelayForwarder.cpp \
            src/Crypto/AsymmetricKey.cpp \
+           src/Crypto/BatchVerifier.cpp \
+           src/Crypto/CppBlake2bHash.cpp \
            src/Crypto/CppDiffieHellman.cpp \
            src/Crypto/CppDsaPrivateKey.cpp \
            src/Crypto/CppDsaPublicKey.cpp \
+           src/Crypto/CppEcDiffieHellman.cpp \
+           src/Crypto/CppEcGroup.cpp \
+           src/Crypto/CppEcPrivateKey.cpp \
+           src/Crypto/CppEcPublicKey.cpp \
+           src/Crypto/CppFixedBaseCache.cpp \
+           src/Crypto/CppFixedBaseTable.cpp \
            src/Crypto/CppHash.cpp \
+           src/Crypto/CppKeystreamGenerator.cpp \
            src/Crypto/CppPrivateKey.cpp \
            src/Crypto/CppPublicKey.cpp \
            src/Crypto/CppRandom.cpp \
+           src/Crypto/CppSha256Hash.cpp \
            src/Crypto/CryptoFactory.cpp \
            src/Crypto/DiffieHellman.cpp \
            src/Crypto/NullDiffieHellman.cpp \
            src/Crypto/NullHash.cpp \
+           src/Crypto/NullKeystreamGenerator.cpp \
            src/Crypto/NullPublicKey.cpp \
            src/Crypto/NullPrivateKey.cpp \
            src/Crypto/OnionEncryptor.cpp \
+           src/Crypto/PadCache.cpp \
+           src/Crypto/PadGenerator.cpp \
+           src/Crypto/SharedSecretCache.cpp \
+           src/Crypto/SlotRandomizer.cpp \
            src/Crypto/ThreadedOnionEncryptor.cpp \
            src/Identity/Group.cpp \
            src/Messaging/RpcHandler.cpp \
@@ -282,10 +320,13 @@ SOURCES += ext/joyent-http-parser/http_parser.c \
            src/Utils/Random.cpp \
            src/Utils/Sleeper.cpp \
            src/Utils/StartStop.cpp \
+           src/Utils/TaskScheduler.cpp \
            src/Utils/Time.cpp \
            src/Utils/Timer.cpp \
            src/Utils/TimerEvent.cpp \
            src/Utils/Utils.cpp \
+           src/Utils/XorKernel.cpp \
+           src/Utils/ZeroRunLength.cpp \
            src/Web/HttpRequest.cpp \
            src/Web/HttpResponse.cpp \
            src/Web/WebRequest.cpp \
@@ -3,11 +3,13 @@
 #include "Crypto/DiffieHellman.hpp"
 #include "Crypto/Hash.hpp"
 #include "Crypto/Library.hpp"
+#include "Crypto/SharedSecretCache.hpp"
 #include "Identity/PublicIdentity.hpp"
 #include "Messaging/Request.hpp"
 #include "Utils/QRunTimeError.hpp"
 #include "Utils/Random.hpp"
 #include "Utils/Serialization.hpp"
+#include "Utils/XorKernel.hpp"
 
 #include "BulkRound.hpp"
 #include "ShuffleRound.hpp"
@@ -18,6 +20,7 @@ using Crypto::CryptoFactory;
 using Crypto::DiffieHellman;
 using Crypto::Hash;
 using Crypto::Library;
+using Crypto::SharedSecretCache;
 using Identity::PublicIdentity;
 using Messaging::Request;
 using Utils::QRunTimeError;
@@ -64,13 +67,7 @@ namespace Anonymity {
 
   void Xor(QByteArray &dst, const QByteArray &t1, const QByteArray &t2)
   {
-    /// @todo use qint64 or qint32 depending on architecture
-    int count = std::min(dst.size(), t1.size());
-    count = std::min(count, t2.size());
-
-    for(int idx = 0; idx < count; idx++) {
-      dst[idx] = t1[idx] ^ t2[idx];
-    }
+    Utils::XorKernel::Xor(dst, t1, t2);
   }
 
   void BulkRound::OnStart()
@@ -466,13 +463,23 @@ namespace Anonymity {
     stream << BulkData << GetRoundId();
 
     _expected_bulk_size = 0;
+    QVector<QByteArray> remote_pubs;
     for(int idx = 0; idx < _shuffle_sink.Count(); idx++) {
       QPair<QSharedPointer<ISender>, QByteArray> pair(_shuffle_sink.At(idx));
       Descriptor des = ParseDescriptor(pair.second);
       _descriptors.append(des);
       if(_my_idx == -1 && _my_descriptor == des) {
         _my_idx = idx;
+      } else {
+        remote_pubs.append(des.PublicDh());
       }
+    }
+
+    // Agree with every descriptor at once, GenerateXorMessage then finds
+    // the secrets in the cache
+    SharedSecretCache::GetSharedSecrets(*GetDhKey(), remote_pubs);
+
+    for(int idx = 0; idx < _descriptors.count(); idx++) {
       stream << GenerateXorMessage(idx);
     }
 
@@ -499,7 +506,8 @@ namespace Anonymity {
     }
 
     Descriptor descriptor = _descriptors[idx];
-    QByteArray seed = GetDhKey()->GetSharedSecret(descriptor.PublicDh());
+    QByteArray seed = SharedSecretCache::GetSharedSecret(*GetDhKey(),
+        descriptor.PublicDh());
 
     Library *lib = CryptoFactory::GetInstance().GetLibrary();
     QScopedPointer<Hash> hashalgo(lib->GetHashAlgorithm());
@@ -1,4 +1,11 @@
+#include <QThreadStorage>
+
+#include "Crypto/BatchVerifier.hpp"
 #include "Crypto/Hash.hpp"
+#include "Crypto/PadCache.hpp"
+#include "Crypto/PadGenerator.hpp"
+#include "Crypto/SharedSecretCache.hpp"
+#include "Crypto/SlotRandomizer.hpp"
 #include "Identity/PublicIdentity.hpp"
 #include "Utils/Random.hpp"
 #include "Utils/QRunTimeError.hpp"
@@ -7,6 +14,8 @@
 #include "Utils/Timer.hpp"
 #include "Utils/TimerCallback.hpp"
 #include "Utils/Utils.hpp"
+#include "Utils/XorKernel.hpp"
+#include "Utils/ZeroRunLength.hpp"
 
 #include "NeffKeyShuffle.hpp"
 #include "CSBulkRound.hpp"
@@ -14,14 +23,33 @@
 const unsigned char bit_masks[8] = {1, 2, 4, 8, 16, 32, 64, 128};
 
 namespace Dissent {
+  using Crypto::BatchVerifier;
   using Crypto::CryptoFactory;
   using Crypto::Hash;
+  using Crypto::KeystreamGenerator;
   using Crypto::Library;
+  using Crypto::PadCache;
+  using Crypto::SharedSecretCache;
+  using Crypto::SlotRandomizer;
   using Identity::PublicIdentity;
   using Utils::QRunTimeError;
   using Utils::Serialization;
+  using Utils::XorKernel;
+  using Utils::ZeroRunLength;
 
 namespace Anonymity {
+namespace {
+  /**
+   * A thread's slot randomizer and the factory generation it was built for
+   */
+  struct ThreadRandomizer {
+    QScopedPointer<SlotRandomizer> randomizer;
+    int generation;
+  };
+}
+
+  int CSBulkRound::_phases_in_flight = 1;
+
   CSBulkRound::CSBulkRound(const Group &group, const PrivateIdentity &ident,
       const Id &round_id, QSharedPointer<Network> network,
       GetDataCallback &get_data, CreateRound create_shuffle) :
@@ -57,15 +85,30 @@ namespace Anonymity {
       InitClient();
     }
 
-    _state->slot_open = false;
+    _state->phases_in_flight = _phases_in_flight;
   }
 
   void CSBulkRound::InitServer()
   {
     _server_state = QSharedPointer<ServerState>(new ServerState());
+    _server_state->pad_cache = QSharedPointer<PadCache>(
+        new PadCache(PAD_CACHE_BYTES, GetTaskGroup()));
+    _server_state->deadline = QSharedPointer<SubmissionDeadline>(
+        new SubmissionDeadline(MIN_CLIENT_SUBMISSION_WINDOW,
+          CLIENT_SUBMISSION_WINDOW, SubmissionDeadline::DEFAULT_PERCENTILE,
+          CLIENT_WINDOW_MULTIPLIER));
+    _server_state->hard_deadline = 0;
     _state = _server_state;
     Q_ASSERT(_state);
 
+#ifdef CSBR_LOG_CLIENT_CIPHERTEXTS
+    _server_state->client_ciphertext_log =
+      QSharedPointer<QTemporaryFile>(new QTemporaryFile());
+    if(!_server_state->client_ciphertext_log->open()) {
+      qCritical() << "Unable to open client ciphertext log";
+    }
+#endif
+
 #ifndef CSBR_RECONNECTS
     foreach(const QSharedPointer<Connection> &con,
         GetNetwork()->GetConnectionManager()->
@@ -151,6 +194,20 @@ namespace Anonymity {
   {
   }
 
+  void CSBulkRound::SetPhasesInFlight(int phases)
+  {
+    if(phases < 1) {
+      qCritical() << "Invalid amount of phases in flight:" << phases;
+      phases = 1;
+    }
+    _phases_in_flight = phases;
+  }
+
+  int CSBulkRound::GetPhasesInFlight()
+  {
+    return _phases_in_flight;
+  }
+
   void CSBulkRound::VerifiableBroadcastToServers(const QByteArray &data)
   {
     Q_ASSERT(IsServer());
@@ -186,6 +243,10 @@ namespace Anonymity {
   {
     if(IsServer()) {
       _server_state->client_ciphertext_period.Stop();
+      // Cancel before waiting on the cache, so its precomputation stops
+      // early rather than running to completion
+      GetTaskGroup()->Cancel();
+      _server_state->pad_cache->Clear();
     }
 
     _state_machine.SetState(FINISHED);
@@ -218,6 +279,22 @@ namespace Anonymity {
     }
   }
 
+  void CSBulkRound::InheritState(const Round &previous)
+  {
+    const CSBulkRound *round = dynamic_cast<const CSBulkRound *>(&previous);
+    if(!round || !_server_state || !round->_server_state) {
+      return;
+    }
+    _server_state->deadline = round->_server_state->deadline;
+
+    // Clients that left the group would otherwise be kept forever
+    QSet<Id> roster;
+    foreach(const PublicIdentity &pi, GetGroup()) {
+      roster.insert(pi.GetId());
+    }
+    _server_state->deadline->RetainClients(roster);
+  }
+
   void CSBulkRound::BeforeStateTransition()
   {
     if(_server_state) {
@@ -230,7 +307,11 @@ namespace Anonymity {
   {
     if(_server_state) {
       _server_state->handled_clients.clear();
-      _server_state->client_ciphertexts.clear();
+      _server_state->client_aggregate.clear();
+#ifdef CSBR_LOG_CLIENT_CIPHERTEXTS
+      _server_state->client_ciphertext_log->resize(0);
+      _server_state->client_ciphertext_log->seek(0);
+#endif
       _server_state->server_ciphertexts.clear();
     }
 
@@ -251,8 +332,21 @@ namespace Anonymity {
     }
 
     QHash<int, QByteArray> signatures;
+    int encoding;
+    QByteArray encoded;
+    stream >> signatures >> encoding >> encoded;
+
     QByteArray cleartext;
-    stream >> signatures >> cleartext;
+    if(encoding == RAW_CLEARTEXT) {
+      cleartext = encoded;
+    } else if(encoding == ZERO_RUN_CLEARTEXT) {
+      if(!ZeroRunLength::Decode(encoded, cleartext, _state->msg_length)) {
+        throw QRunTimeError("Malformed cleartext encoding");
+      }
+    } else {
+      throw QRunTimeError("Unknown cleartext encoding: " +
+          QString::number(encoding));
+    }
 
     if(cleartext.size() != _state->msg_length) {
       throw QRunTimeError("Cleartext size mismatch: " +
@@ -260,14 +354,16 @@ namespace Anonymity {
           QString::number(_state->msg_length));
     }
 
+    BatchVerifier verifier;
     int server_length = GetGroup().GetSubgroup().Count();
     for(int idx = 0; idx < server_length; idx++) {
-      if(!GetGroup().GetSubgroup().GetKey(idx)->Verify(cleartext,
-            signatures[idx]))
-      {
-        Stop("Failed to verify signatures");
-        return;
-      }
+      verifier.Add(GetGroup().GetSubgroup().GetKey(idx), cleartext,
+          signatures[idx]);
+    }
+
+    if(!verifier.VerifyAll()) {
+      Stop("Failed to verify signatures");
+      return;
     }
 
     _state->cleartext = cleartext;
@@ -300,24 +396,32 @@ namespace Anonymity {
     }
 
     _server_state->handled_clients.insert(from);
-    _server_state->client_ciphertexts.append(payload);
+    XorKernel::XorInPlace(_server_state->client_aggregate, payload);
+
+    qint64 elapsed = Utils::Time::GetInstance().MSecsSinceEpoch() -
+      _server_state->start_of_phase;
+    _server_state->deadline->AddArrival(from, elapsed);
+
+#ifdef CSBR_LOG_CLIENT_CIPHERTEXTS
+    QDataStream log(_server_state->client_ciphertext_log.data());
+    log << GetGroup().GetIndex(from) << payload;
+#endif
 
     qDebug() << GetGroup().GetIndex(GetLocalId()) << GetLocalId().ToString() <<
       ": received client ciphertext from" << GetGroup().GetIndex(from) <<
-      from.ToString() << "Have" << _server_state->client_ciphertexts.count()
+      from.ToString() << "Have" << _server_state->handled_clients.count()
       << "expecting" << _server_state->allowed_clients.count();
 
     if(_server_state->allowed_clients.count() ==
-        _server_state->client_ciphertexts.count())
+        _server_state->handled_clients.count())
     {
       _state_machine.StateComplete();
-    } else if(_server_state->client_ciphertexts.count() ==
+    } else if(_server_state->handled_clients.count() ==
         _server_state->expected_clients)
     {
       // Start the flexible deadline
       _server_state->client_ciphertext_period.Stop();
-      int window = Utils::Time::GetInstance().MSecsSinceEpoch() -
-        _server_state->start_of_phase;
+      int window = int(_server_state->deadline->GetFlexWindow(elapsed));
       Utils::TimerCallback *cb = new Utils::TimerMethod<CSBulkRound, int>(
           this, &CSBulkRound::ConcludeClientCiphertextSubmission, 0);
       _server_state->client_ciphertext_period =
@@ -413,9 +517,8 @@ namespace Anonymity {
           QString::number(_server_state->msg_length));
     }
 
-    Library *lib = CryptoFactory::GetInstance().GetLibrary();
-    QSharedPointer<Hash> hashalgo(lib->GetHashAlgorithm());
-    QByteArray commit = hashalgo->ComputeHash(ciphertext);
+    Hash &hashalgo = CryptoFactory::GetInstance().GetThreadHash();
+    QByteArray commit = hashalgo.ComputeHash(ciphertext);
 
     if(commit != _server_state->server_commits[
         GetGroup().GetSubgroup().GetIndex(from)])
@@ -572,90 +675,145 @@ namespace Anonymity {
       roster = GetGroup().GetSubgroup().GetRoster();
     }
 
+    QVector<QByteArray> remote_pubs;
+    foreach(const PublicIdentity &gc, roster) {
+      if(gc.GetId() != GetLocalId()) {
+        remote_pubs.append(gc.GetDhKey());
+      }
+    }
+
+    // Only the derivation with the round id is per round, the raw secrets
+    // carry over from earlier rounds with the same keys
+    const DiffieHellman &dh_key = *GetPrivateIdentity().GetDhKey();
+    SharedSecretCache::Retain(dh_key, remote_pubs);
+    QVector<QByteArray> shared_secrets =
+      SharedSecretCache::GetSharedSecrets(dh_key, remote_pubs);
+
+    Hash &hashalgo = CryptoFactory::GetInstance().GetThreadHash();
+
+    int secret_idx = 0;
     foreach(const PublicIdentity &gc, roster) {
       if(gc.GetId() == GetLocalId()) {
         _state->base_seeds.append(QByteArray());
         continue;
       }
-      QByteArray base_seed =
-        GetPrivateIdentity().GetDhKey()->GetSharedSecret(gc.GetDhKey());
-      _state->base_seeds.append(base_seed);
+      hashalgo.Update(shared_secrets[secret_idx++]);
+      hashalgo.Update(GetRoundId().GetByteArray());
+      _state->base_seeds.append(hashalgo.ComputeHash());
     }
   }
 
-  void CSBulkRound::SetupRngs()
+  QByteArray CSBulkRound::GetPhaseNonce(int phase) const
   {
-    Library *lib = CryptoFactory::GetInstance().GetLibrary();
-    QSharedPointer<Hash> hashalgo(lib->GetHashAlgorithm());
+    QByteArray nonce(4, 0);
+    Serialization::WriteInt(phase, nonce, 0);
+    return nonce;
+  }
 
-    QByteArray phase(4, 0);
-    Serialization::WriteInt(_state_machine.GetPhase(), phase, 0);
+  int CSBulkRound::GetMessageLength(int phase) const
+  {
+    int length = _state->base_msg_length;
+    foreach(int slot_length, _state->slot_layouts.value(phase)) {
+      length += slot_length;
+    }
+    return length;
+  }
 
-    _state->anonymous_rngs.clear();
+  void CSBulkRound::SetupRngs(int phase_number)
+  {
+    Library *lib = CryptoFactory::GetInstance().GetLibrary();
+    QByteArray phase = GetPhaseNonce(phase_number);
 
-    QList<QByteArray> seeds = _state->base_seeds;
-    if(IsServer()) {
-      seeds = QList<QByteArray>();
-      foreach(const Id &id, _server_state->handled_clients) {
-        int idx = GetGroup().GetIndex(id);
-        seeds.append(_state->base_seeds[idx]);
-      }
+    _state->anonymous_rngs.clear();
 
-      for(int idx = 0; idx < GetGroup().GetSubgroup().Count(); idx++) {
-        const Id &id = GetGroup().GetSubgroup().GetId(idx);
-        if(id == GetLocalId()) {
-          continue;
-        }
-        int jdx = GetGroup().GetIndex(id);
-        seeds.append(_state->base_seeds[jdx]);
+    foreach(const QByteArray &base_seed, _state->base_seeds) {
+      if(base_seed.isEmpty()) {
+        continue;
       }
+      QSharedPointer<KeystreamGenerator> rng(
+          lib->GetKeystreamGenerator(base_seed, phase));
+      _state->anonymous_rngs.append(rng);
     }
+  }
 
-    foreach(const QByteArray &base_seed, seeds) {
+  void CSBulkRound::PrecomputePads()
+  {
+    Library *lib = CryptoFactory::GetInstance().GetLibrary();
+    QByteArray phase = GetPhaseNonce(_state_machine.GetPhase());
+
+    // Any client may end up in the agreed upon client list, not just those
+    // connected to this server
+    QHash<int, QSharedPointer<KeystreamGenerator> > rngs;
+    for(int idx = 0; idx < _state->base_seeds.count(); idx++) {
+      const QByteArray &base_seed = _state->base_seeds[idx];
       if(base_seed.isEmpty()) {
         continue;
       }
-      hashalgo->Update(base_seed);
-      hashalgo->Update(phase);
-      hashalgo->Update(GetRoundId().GetByteArray());
-      QByteArray seed = hashalgo->ComputeHash();
-      QSharedPointer<Random> rng(lib->GetRandomNumberGenerator(seed));
-      _state->anonymous_rngs.append(rng);
+      rngs[idx] = QSharedPointer<KeystreamGenerator>(
+          lib->GetKeystreamGenerator(base_seed, phase));
     }
+
+    _server_state->pad_cache->Precompute(rngs, _state->msg_length);
   }
 
   void CSBulkRound::SubmitClientCiphertext()
   {
-    SetupRngs();
+    // Keep phases_in_flight phases submitted past the last cleartext, the
+    // slot layout of each is known by now
+    int last = _state_machine.GetPhase() + _state->phases_in_flight - 1;
+    while(_state->last_submitted < last) {
+      int phase = ++_state->last_submitted;
+      SetupRngs(phase);
+
+      QByteArray payload;
+      QDataStream stream(&payload, QIODevice::WriteOnly);
+      stream << CLIENT_CIPHERTEXT << GetRoundId() << phase
+        << GenerateCiphertext(phase);
+
+      VerifiableSend(_state->my_server, payload);
+    }
+  }
 
-    QByteArray payload;
-    QDataStream stream(&payload, QIODevice::WriteOnly);
-    stream << CLIENT_CIPHERTEXT << GetRoundId() << _state_machine.GetPhase()
-      << GenerateCiphertext();
+  QByteArray CSBulkRound::GeneratePad(int length)
+  {
+    QByteArray pad(length, 0);
+    if(!IsServer()) {
+      Crypto::PadGenerator::XorPads(_state->anonymous_rngs, pad);
+      return pad;
+    }
+
+    QList<int> indexes;
+    foreach(const Id &id, _server_state->handled_clients) {
+      indexes.append(GetGroup().GetIndex(id));
+    }
+
+    foreach(const PublicIdentity &pi, GetGroup().GetSubgroup()) {
+      if(pi.GetId() != GetLocalId()) {
+        indexes.append(GetGroup().GetIndex(pi.GetId()));
+      }
+    }
 
-    VerifiableSend(_state->my_server, payload);
+    int count = _server_state->pad_cache->XorPads(indexes, pad);
+    qDebug() << ToString() << "generating ciphertext for" << count <<
+      "out of" << GetGroup().Count();
+    return pad;
   }
 
-  QByteArray CSBulkRound::GenerateCiphertext()
+  QByteArray CSBulkRound::GenerateCiphertext(int phase)
   {
-    QByteArray xor_msg(_state->msg_length, 0);
-    QByteArray tmsg(_state->msg_length, 0);
-    
-    foreach(const QSharedPointer<Random> &rng, _state->anonymous_rngs) {
-      rng->GenerateBlock(tmsg);
-      Xor(xor_msg, xor_msg, tmsg);
-    }
+    const QMap<int, int> layout = _state->slot_layouts.value(phase);
+    QByteArray xor_msg = GeneratePad(GetMessageLength(phase));
 
-    if(_state->slot_open) {
+    if(layout.contains(_state->my_idx)) {
       int offset = _state->base_msg_length;
-      foreach(int owner, _state->next_messages.keys()) {
+      foreach(int owner, layout.keys()) {
         if(owner == _state->my_idx) {
           break;
         }
-        offset += _state->next_messages[owner];
+        offset += layout[owner];
       }
 
-      QByteArray my_msg = GenerateSlotMessage();
+      QByteArray my_msg = GenerateSlotMessage(phase);
       QByteArray my_xor_base = QByteArray::fromRawData(xor_msg.constData() +
           offset, my_msg.size());
       Xor(my_msg, my_msg, my_xor_base);
@@ -664,12 +822,17 @@ namespace Anonymity {
       qDebug() << "Writing ciphertext into my slot" << _state->my_idx <<
         "starting at" << offset << "for" << my_msg.size() << "bytes.";
 
-    } else if(CheckData()) {
+    } else if((_state->open_phase == -1 ||
+          _state->open_phase + _state->phases_in_flight <= phase) &&
+        CheckData())
+    {
+      // The slot appears phases_in_flight phases later, starting with an
+      // empty message that announces the length of the first real one
       qDebug() << "Opening my slot" << _state->my_idx;
       xor_msg[_state->my_idx / 8] = xor_msg[_state->my_idx / 8] ^
         bit_masks[_state->my_idx % 8];
-      _state->read = false;
-      _state->slot_open = true;
+      _state->open_phase = phase;
+      _state->scheduled_msgs[phase + _state->phases_in_flight] = QByteArray();
     }
 
     return xor_msg;
@@ -686,28 +849,53 @@ namespace Anonymity {
       qDebug() << "Found a message of" << pair.first.size();
     }
     _state->next_msg = pair.first;
-    _state->last_msg = QByteArray();
     return !_state->next_msg.isEmpty();
   }
 
-  QByteArray CSBulkRound::GenerateSlotMessage()
+  QByteArray CSBulkRound::FetchData()
   {
-    QByteArray msg = _state->next_msg;
-    if(_state->read) {
-      QPair<QByteArray, bool> pair = GetData(MAX_GET);
-      _state->last_msg = _state->next_msg;
-      _state->next_msg = pair.first;
-    } else {
-      msg = _state->last_msg;
-      _state->read = true;
+    if(!_state->next_msg.isEmpty()) {
+      QByteArray msg = _state->next_msg;
+      _state->next_msg = QByteArray();
+      return msg;
+    }
+    return GetData(MAX_GET).first;
+  }
+
+  void CSBulkRound::RescheduleMessage(int phase)
+  {
+    // The slot keeps its length, so the lost message is sent again in the
+    // slot's next phase and whatever was queued there moves back one turn
+    if(!_state->sent_msgs.contains(phase)) {
+      return;
     }
 
+    int next_phase = phase + _state->phases_in_flight;
+    if(_state->scheduled_msgs.contains(next_phase)) {
+      _state->scheduled_msgs[next_phase + _state->phases_in_flight] =
+        _state->scheduled_msgs[next_phase];
+    }
+    _state->scheduled_msgs[next_phase] = _state->sent_msgs[phase];
+  }
+
+  QByteArray CSBulkRound::GenerateSlotMessage(int phase)
+  {
+    // A slot message carries the length of this slot phases_in_flight
+    // phases from now, so the message sent then is fetched now
+    QByteArray msg = _state->scheduled_msgs.take(phase);
+    int next_phase = phase + _state->phases_in_flight;
+    if(!_state->scheduled_msgs.contains(next_phase)) {
+      _state->scheduled_msgs[next_phase] = FetchData();
+    }
+    int next_size = _state->scheduled_msgs[next_phase].size();
+    _state->sent_msgs[phase] = msg;
+
     QByteArray msg_p(8, 0);
-    Serialization::WriteInt(_state_machine.GetPhase(), msg_p, 0);
-    int length = _state->next_msg.size() + SlotHeaderLength(_state->my_idx);
+    Serialization::WriteInt(phase, msg_p, 0);
+    int length = next_size + SlotHeaderLength(_state->my_idx);
 #ifdef CSBR_CLOSE_SLOT
-    if(_state->next_msg.size() == 0) {
-      _state->slot_open = false;
+    if(next_size == 0) {
+      _state->scheduled_msgs.remove(next_phase);
       length = 0;
     }
 #endif
@@ -743,20 +931,28 @@ namespace Anonymity {
     }
 #endif
 
+    _server_state->client_aggregate = QByteArray(_state->msg_length, 0);
+    _server_state->start_of_phase =
+      Utils::Time::GetInstance().MSecsSinceEpoch();
+    PrecomputePads();
+
     if(_server_state->allowed_clients.count() == 0) {
       _state_machine.StateComplete();
       return;
     }
 
     // This is the hard deadline
+    _server_state->hard_deadline = _server_state->deadline->GetHardDeadline();
+    int window = int(_server_state->hard_deadline);
     Utils::TimerCallback *cb = new Utils::TimerMethod<CSBulkRound, int>(
         this, &CSBulkRound::ConcludeClientCiphertextSubmission, 0);
     _server_state->client_ciphertext_period =
-      Utils::Timer::GetInstance().QueueCallback(cb, CLIENT_SUBMISSION_WINDOW);
+      Utils::Timer::GetInstance().QueueCallback(cb, window);
+
+    qDebug() << GetGroup().GetIndex(GetLocalId()) << GetLocalId().ToString() <<
+      "setting client submission deadline:" << window;
 
     // Setup the flex-deadline
-    _server_state->start_of_phase =
-      Utils::Time::GetInstance().MSecsSinceEpoch();
     _server_state->expected_clients =
       int(_server_state->allowed_clients.count() * CLIENT_PERCENTAGE);
   }
@@ -770,6 +966,18 @@ namespace Anonymity {
 
   void CSBulkRound::SubmitClientList()
   {
+    qint64 duration = Utils::Time::GetInstance().MSecsSinceEpoch() -
+      _server_state->start_of_phase;
+    QList<Id> excluded = (_server_state->allowed_clients -
+        _server_state->handled_clients).toList();
+    _server_state->deadline->PhaseFinished(duration, excluded,
+        _server_state->hard_deadline);
+
+    qDebug() << GetGroup().GetIndex(GetLocalId()) << GetLocalId().ToString() <<
+      "client submission phase:" << _state_machine.GetPhase() <<
+      "duration:" << duration << "excluded clients:" << excluded.count() <<
+      "total excluded:" << _server_state->deadline->GetTotalExcluded();
+
     QByteArray payload;
     QDataStream stream(&payload, QIODevice::WriteOnly);
     stream << SERVER_CLIENT_LIST << GetRoundId() <<
@@ -780,11 +988,6 @@ namespace Anonymity {
 
   void CSBulkRound::SubmitCommit()
   {
-    SetupRngs();
-
-    qDebug() << ToString() << "generating ciphertext for" <<
-      _state->anonymous_rngs.count() << "out of" << GetGroup().Count();
-
     GenerateServerCiphertext();
 
     QByteArray payload;
@@ -797,15 +1000,12 @@ namespace Anonymity {
 
   void CSBulkRound::GenerateServerCiphertext()
   {
-    QByteArray ciphertext = GenerateCiphertext();
-    foreach(const QByteArray &text, _server_state->client_ciphertexts) {
-      Xor(ciphertext, ciphertext, text);
-    }
+    QByteArray ciphertext = GenerateCiphertext(_state_machine.GetPhase());
+    XorKernel::XorInPlace(ciphertext, _server_state->client_aggregate);
     _server_state->my_ciphertext = ciphertext;
 
-    Library *lib = CryptoFactory::GetInstance().GetLibrary();
-    QSharedPointer<Hash> hashalgo(lib->GetHashAlgorithm());
-    _server_state->my_commit = hashalgo->ComputeHash(ciphertext);
+    _server_state->my_commit =
+      CryptoFactory::GetInstance().GetThreadHash().ComputeHash(ciphertext);
   }
 
   void CSBulkRound::SubmitServerCiphertext()
@@ -821,10 +1021,7 @@ namespace Anonymity {
   void CSBulkRound::SubmitValidation()
   {
     QByteArray cleartext(_state->msg_length, 0);
-
-    foreach(const QByteArray &ciphertext, _server_state->server_ciphertexts) {
-      Xor(cleartext, cleartext, ciphertext);
-    }
+    XorKernel::XorMany(cleartext, _server_state->server_ciphertexts.values());
 
     _state->cleartext = cleartext;
     QByteArray signature = GetPrivateIdentity().GetSigningKey()->
@@ -840,10 +1037,19 @@ namespace Anonymity {
 
   void CSBulkRound::PushCleartext()
   {
+    // Most of a cleartext is usually zeroes: unset slot request bits and
+    // empty slots, only send the encoded form if it actually helps
+    int encoding = ZERO_RUN_CLEARTEXT;
+    QByteArray encoded = ZeroRunLength::Encode(_server_state->cleartext);
+    if(encoded.size() >= _server_state->cleartext.size()) {
+      encoding = RAW_CLEARTEXT;
+      encoded = _server_state->cleartext;
+    }
+
     QByteArray payload;
     QDataStream stream(&payload, QIODevice::WriteOnly);
     stream << SERVER_CLEARTEXT << GetRoundId() << _state_machine.GetPhase()
-      << _server_state->signatures << _server_state->cleartext;
+      << _server_state->signatures << encoding << encoded;
 
     VerifiableBroadcastToClients(payload);
     ProcessCleartext();
@@ -852,13 +1058,14 @@ namespace Anonymity {
 
   void CSBulkRound::ProcessCleartext()
   {
-    int next_msg_length = _state->base_msg_length;
+    int current_phase = _state_machine.GetPhase();
+    QMap<int, int> layout = _state->slot_layouts.take(current_phase);
+
     QMap<int, int> next_msgs;
     for(int idx = 0; idx < GetGroup().Count(); idx++) {
       if(_state->cleartext[idx / 8] & bit_masks[idx % 8]) {
         int length = SlotHeaderLength(idx);
         next_msgs[idx] = length;
-        next_msg_length += length;
         qDebug() << "Opening slot" << idx;
       }
     }
@@ -868,22 +1075,51 @@ namespace Anonymity {
       ++offset;
     }
 
-    foreach(int owner, _state->next_messages.keys()) {
-      int msg_length = _state->next_messages[owner];
+    // Parse every slot first so that their signatures can be verified
+    // together on the crypto thread pool, then handle them in slot order
+    QList<QByteArray> slot_msgs;
+    QList<int> checks;
+    BatchVerifier verifier;
+
+    foreach(int owner, layout.keys()) {
+      int msg_length = layout[owner];
 
       QByteArray msg_ppp = QByteArray::fromRawData(
           _state->cleartext.constData() + offset, msg_length);
       offset += msg_length;
 
       QByteArray msg_pp = Derandomize(msg_ppp);
+      slot_msgs.append(msg_pp);
+
+      int sig_length = _state->anonymous_keys[owner]->GetSignatureLength();
+      if(msg_pp.size() < 9 + sig_length ||
+          Serialization::ReadInt(msg_pp, 1) != current_phase)
+      {
+        checks.append(-1);
+        continue;
+      }
+
+      QByteArray msg_p = QByteArray::fromRawData(
+          msg_pp.constData() + 1, msg_pp.size() - 1 - sig_length);
+      QByteArray sig = QByteArray::fromRawData(
+          msg_pp.constData() + 1 + msg_p.size(), sig_length);
+      checks.append(verifier.Add(_state->anonymous_keys[owner], msg_p, sig));
+    }
+
+    QVector<bool> verified = verifier.Verify();
+
+    int slot = -1;
+    foreach(int owner, layout.keys()) {
+      slot++;
+      int msg_length = layout[owner];
+      const QByteArray &msg_pp = slot_msgs[slot];
+
       if(msg_pp.isEmpty()) {
         qDebug() << "No message at" << owner;
-        next_msg_length += msg_length;
         next_msgs[owner] = msg_length;
 
         if(_state->my_idx == owner) {
-          _state->read = false;
-          _state->slot_open = true;
+          RescheduleMessage(current_phase);
           qDebug() << "My message didn't make it in time.";
         }
         continue;
@@ -892,34 +1128,29 @@ namespace Anonymity {
       if(msg_pp[0] != char(0)) {
         qWarning() << "Accusation generated by" << owner;
       }
-      
-      QSharedPointer<AsymmetricKey> vkey(_state->anonymous_keys[owner]);
-      int sig_length = vkey->GetKeySize() / 8;
 
-      QByteArray msg_p = QByteArray::fromRawData(
-          msg_pp.constData() + 1, msg_pp.size() - 1 - sig_length);
-      QByteArray sig = QByteArray::fromRawData(
-          msg_pp.constData() + 1 + msg_p.size(), sig_length);
-
-      int phase = Serialization::ReadInt(msg_p, 0);
-      if(phase != _state_machine.GetPhase()) {
+      int sig_length = _state->anonymous_keys[owner]->GetSignatureLength();
+      if(msg_pp.size() >= 9 + sig_length &&
+          Serialization::ReadInt(msg_pp, 1) != current_phase)
+      {
         qDebug() << "Incorrect phase, skipping message";
         continue;
       }
 
-      if(!vkey->Verify(msg_p, sig)) {
+      if(checks[slot] == -1 || !verified[checks[slot]]) {
         qDebug() << "Unable to verify message for peer at" << owner;
-        next_msg_length += msg_length;
         next_msgs[owner] = msg_length;
 
         if(owner == _state->my_idx) {
-          _state->read = false;
-          _state->slot_open = true;
+          RescheduleMessage(current_phase);
           qDebug() << "My message got corrupted, restransmitting";
         }
         continue;
       }
 
+      QByteArray msg_p = QByteArray::fromRawData(
+          msg_pp.constData() + 1, msg_pp.size() - 1 - sig_length);
+
       int next = Serialization::ReadInt(msg_p, 4);
       if(next < 0) {
         qDebug() << "Invalid next message size, skipping message";
@@ -927,7 +1158,6 @@ namespace Anonymity {
       } else if(next > 0) {
         qDebug() << "Slot" << owner << "next message length:" << next;
         next_msgs[owner] = next;
-        next_msg_length += next;
       } else {
         qDebug() << "Slot" << owner << "closing";
       }
@@ -939,58 +1169,48 @@ namespace Anonymity {
       }
     }
 
-    _state->next_messages = next_msgs;
-    _state->msg_length = next_msg_length;
+    // The slots described by this phase belong to the phase
+    // phases_in_flight ahead, the next phase's layout is already known
+    _state->slot_layouts[current_phase + _state->phases_in_flight] = next_msgs;
+    _state->sent_msgs.remove(current_phase);
+    _state->msg_length = GetMessageLength(current_phase + 1);
   }
 
   QByteArray CSBulkRound::NullSeed()
   {
-    static QByteArray null_seed(
+    return QByteArray(
         CryptoFactory::GetInstance().GetLibrary()->RngOptimalSeedSize(), 0);
-    return null_seed;
   }
 
-  QByteArray CSBulkRound::Randomize(const QByteArray &msg)
+  SlotRandomizer &CSBulkRound::GetSlotRandomizer()
   {
-    Library *lib = CryptoFactory::GetInstance().GetLibrary();
-
-    QSharedPointer<Random> rng0(lib->GetRandomNumberGenerator());
-    QByteArray seed(lib->RngOptimalSeedSize(), 0);
-    do {
-      rng0->GenerateBlock(seed);
-    } while(seed == NullSeed());
-
-    QSharedPointer<Random> rng1(lib->GetRandomNumberGenerator(seed));
-    QByteArray random_text(msg.size(), 0);
-    rng1->GenerateBlock(random_text);
+    static QThreadStorage<ThreadRandomizer *> randomizers;
+
+    // Library pointers may be reused after a switch, so key on the factory's
+    // generation instead
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    int generation = cf.GetGeneration();
+    if(!randomizers.hasLocalData()) {
+      randomizers.setLocalData(new ThreadRandomizer());
+      randomizers.localData()->generation = generation - 1;
+    }
 
-    Xor(random_text, random_text, msg);
+    ThreadRandomizer *randomizer = randomizers.localData();
+    if(randomizer->generation != generation) {
+      randomizer->randomizer.reset(new SlotRandomizer(cf.GetLibrary()));
+      randomizer->generation = generation;
+    }
+    return *randomizer->randomizer;
+  }
 
-    return seed + random_text;
+  QByteArray CSBulkRound::Randomize(const QByteArray &msg)
+  {
+    return GetSlotRandomizer().Randomize(msg);
   }
 
   QByteArray CSBulkRound::Derandomize(const QByteArray &randomized_text)
   {
-    Library *lib = CryptoFactory::GetInstance().GetLibrary();
-
-    QByteArray seed = QByteArray::fromRawData(randomized_text.constData(),
-        lib->RngOptimalSeedSize());
-
-    if(seed == NullSeed()) {
-      return QByteArray();
-    }
-
-    QSharedPointer<Random> rng(lib->GetRandomNumberGenerator(seed));
-
-    QByteArray msg = QByteArray::fromRawData(
-        randomized_text.constData() + seed.size(),
-        randomized_text.size() - seed.size());
-
-    QByteArray random_text(msg.size(), 0);
-    rng->GenerateBlock(random_text);
-
-    Xor(random_text, random_text, msg);
-    return random_text;
+    return GetSlotRandomizer().Derandomize(randomized_text);
   }
 }
 }
@@ -2,12 +2,22 @@
 #define DISSENT_ANONYMITY_CS_BULK_ROUND_H_GUARD
 
 #include <QMetaEnum>
+#ifdef CSBR_LOG_CLIENT_CIPHERTEXTS
+#include <QTemporaryFile>
+#endif
 
 #include "Utils/TimerEvent.hpp"
 #include "RoundStateMachine.hpp"
 #include "BaseBulkRound.hpp"
+#include "SubmissionDeadline.hpp"
 
 namespace Dissent {
+namespace Crypto {
+  class KeystreamGenerator;
+  class PadCache;
+  class SlotRandomizer;
+}
+
 namespace Utils {
   class Random;
 }
@@ -53,6 +63,15 @@ namespace Anonymity {
         SERVER_CLEARTEXT,
       };
 
+      /**
+       * Encodings for the cleartext in SERVER_CLEARTEXT messages, signatures
+       * always cover the decoded cleartext
+       */
+      enum CleartextEncoding {
+        RAW_CLEARTEXT = 0,
+        ZERO_RUN_CLEARTEXT,
+      };
+
       enum States {
         OFFLINE = 0,
         SHUFFLING,
@@ -152,20 +171,53 @@ namespace Anonymity {
 
       virtual void HandleDisconnect(const Id &id);
 
+      /**
+       * Servers keep the submission latency history of the previous round
+       */
+      virtual void InheritState(const Round &previous);
+
       /**
        * Delay between the start of a round and when all clients are required
-       * to have submitted a message in order to be valid
+       * to have submitted a message in order to be valid, used until
+       * submission latencies have been observed and as an upper bound after
        */
       static const int CLIENT_SUBMISSION_WINDOW = 120000;
 
+      /**
+       * Lower bound for the adaptive client submission deadline
+       */
+      static const int MIN_CLIENT_SUBMISSION_WINDOW = 1000;
+
       static const float CLIENT_PERCENTAGE = .95;
 
       static const float CLIENT_WINDOW_MULTIPLIER = 2.0;
 
       static const int MAX_GET = 4096;
 
+      /**
+       * Sets the amount of phases that may be in flight at once for rounds
+       * constructed afterward.  With a single phase, clients wait for the
+       * cleartext of a phase before submitting the next.  With more, clients
+       * submit ahead while the servers are still working on earlier phases
+       * and a slot's length is set by the message sent that many phases
+       * earlier.  All members must use the same value.
+       * @param phases the amount of phases in flight, at least 1
+       */
+      static void SetPhasesInFlight(int phases);
+
+      /**
+       * Returns the amount of phases in flight used by new rounds
+       */
+      static int GetPhasesInFlight();
+
+      /**
+       * Maximum amount of precomputed pad bytes a server holds per phase
+       */
+      static const qint64 PAD_CACHE_BYTES = 64 * 1024 * 1024;
+
     protected:
       typedef Utils::Random Random;
+      typedef Crypto::KeystreamGenerator KeystreamGenerator;
 
       /**
        * Funnels data into the RoundStateMachine for evaluation
@@ -205,23 +257,25 @@ namespace Anonymity {
        */
       class State {
         public:
-          State() : accuse(false) {}
+          State() : accuse(false), open_phase(-1), last_submitted(-1) {}
           virtual ~State() {}
 
           QVector<QSharedPointer<AsymmetricKey> > anonymous_keys;
           QList<QByteArray> base_seeds;
-          QVector<QSharedPointer<Random> > anonymous_rngs;
-          QMap<int, int> next_messages;
+          QVector<QSharedPointer<KeystreamGenerator> > anonymous_rngs;
+          QHash<int, QMap<int, int> > slot_layouts;
           QHash<int, QByteArray> signatures;
           QByteArray cleartext;
 
           QSharedPointer<AsymmetricKey> anonymous_key;
           QByteArray shuffle_data;
-          bool read;
-          bool slot_open;
           bool accuse;
           QByteArray next_msg;
-          QByteArray last_msg;
+          QHash<int, QByteArray> scheduled_msgs;
+          QHash<int, QByteArray> sent_msgs;
+          int open_phase;
+          int last_submitted;
+          int phases_in_flight;
           int msg_length;
           int base_msg_length;
           int my_idx;
@@ -237,16 +291,23 @@ namespace Anonymity {
 
           Utils::TimerEvent client_ciphertext_period;
           qint64 start_of_phase;
+          qint64 hard_deadline;
           int expected_clients;
+          QSharedPointer<SubmissionDeadline> deadline;
 
           int phase;
 
           QByteArray my_commit;
           QByteArray my_ciphertext;
 
+          QSharedPointer<Crypto::PadCache> pad_cache;
+
           QSet<Id> allowed_clients;
           QSet<Id> handled_clients;
-          QList<QByteArray> client_ciphertexts;
+          QByteArray client_aggregate;
+#ifdef CSBR_LOG_CLIENT_CIPHERTEXTS
+          QSharedPointer<QTemporaryFile> client_ciphertext_log;
+#endif
 
           QSet<Id> handled_servers;
           QHash<int, QByteArray> server_commits;
@@ -298,7 +359,11 @@ namespace Anonymity {
       virtual void ShuffleFinished();
 
       /**
-       * Server handles client ciphertext messages
+       * Server handles client ciphertext messages, each ciphertext is folded
+       * into the running aggregate upon arrival.  If
+       * CSBR_LOG_CLIENT_CIPHERTEXTS is defined, the raw ciphertexts are also
+       * appended to a temporary file for blame, so memory use stays
+       * independent of the amount of clients.
        * @param from sender of the message
        * @param stream message
        */
@@ -333,22 +398,45 @@ namespace Anonymity {
       void HandleServerValidation(const Id &from, QDataStream &stream);
 
       /**
-       * Client handles server cleartext message
+       * Client handles server cleartext message, decoding the cleartext
+       * before verifying the server signatures
        * @param from sender of the message
        * @param stream message
        */
       void HandleServerCleartext(const Id &from, QDataStream &stream);
 
       /**
-       * Decoupled as to not waste resources if the shuffle doesn't succeed
+       * Decoupled as to not waste resources if the shuffle doesn't succeed,
+       * derives a per-round seed from each shared secret and the RoundID
        */
       void SetupRngSeeds();
 
       /**
-       * For clients, this is a trivial setup, one for each server, servers
-       * need to set this after determining the online client set.
+       * Sets up the client's keystreams, one for each server.  Each keystream
+       * uses the per-round seed and the phase as the nonce.
+       * @param phase the phase the keystreams are used for
+       */
+      void SetupRngs(int phase);
+
+      /**
+       * Servers begin generating the pads for every other member in the
+       * background, so that they are ready by the time the online client set
+       * has been agreed upon
        */
-      void SetupRngs();
+      void PrecomputePads();
+
+      /**
+       * Returns the nonce used by the keystreams during a phase
+       * @param phase the phase
+       */
+      QByteArray GetPhaseNonce(int phase) const;
+
+      /**
+       * Returns the DC-net message length of a phase, the phase's slot layout
+       * must already be known
+       * @param phase the phase
+       */
+      int GetMessageLength(int phase) const;
 
       /* Below are the state transitions */
       void StartShuffle();
@@ -365,9 +453,12 @@ namespace Anonymity {
 
       /* Below are the ciphertext generation helpers */
       void GenerateServerCiphertext();
-      QByteArray GenerateCiphertext();
-      QByteArray GenerateSlotMessage();
+      QByteArray GeneratePad(int length);
+      QByteArray GenerateCiphertext(int phase);
+      QByteArray GenerateSlotMessage(int phase);
       bool CheckData();
+      QByteArray FetchData();
+      void RescheduleMessage(int phase);
 
       void ProcessCleartext();
       void ConcludeClientCiphertextSubmission(const int &);
@@ -376,13 +467,19 @@ namespace Anonymity {
       {
         Crypto::Library *lib = Crypto::CryptoFactory::GetInstance().GetLibrary();
         return 9 + lib->RngOptimalSeedSize() +
-          (_state->anonymous_keys[slot_idx]->GetKeySize() / 8);
+          _state->anonymous_keys[slot_idx]->GetSignatureLength();
       }
 
+      /**
+       * Returns this thread's slot randomizer for the current library
+       */
+      static Crypto::SlotRandomizer &GetSlotRandomizer();
+
       QSharedPointer<ServerState> _server_state;
       QSharedPointer<State> _state;
       RoundStateMachine<CSBulkRound> _state_machine;
       bool _stop_next;
+      static int _phases_in_flight;
   };
 }
 }
@@ -3,12 +3,14 @@
 
 #include "Crypto/CryptoFactory.hpp"
 #include "Utils/Random.hpp"
+#include "Utils/XorKernel.hpp"
 
 #include "MessageRandomizer.hpp"
 
 using Dissent::Crypto::CryptoFactory;
 using Dissent::Crypto::Library;
 using Dissent::Utils::Random;
+using Dissent::Utils::XorKernel;
 
 namespace Dissent {
 namespace Anonymity {
@@ -64,10 +66,7 @@ namespace Anonymity {
     }
 
     QByteArray out(len, 0);
-    for(int i=0; i<len; i++) {
-      out[i] = first[i] ^ second[i];
-    }
-
+    XorKernel::Xor(out, first, second);
     return out;
   }
 
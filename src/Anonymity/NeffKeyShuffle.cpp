@@ -1,5 +1,8 @@
 #include "Crypto/CppDsaPrivateKey.hpp"
 #include "Crypto/CppDsaPublicKey.hpp"
+#include "Crypto/CppEcGroup.hpp"
+#include "Crypto/CppEcPrivateKey.hpp"
+#include "Crypto/CppInteger.hpp"
 #include "Utils/QRunTimeError.hpp"
 #include "Utils/Timer.hpp"
 #include "Utils/TimerCallback.hpp"
@@ -9,9 +12,15 @@
 namespace Dissent {
   using Crypto::CppDsaPrivateKey;
   using Crypto::CppDsaPublicKey;
+  using Crypto::CppEcGroup;
+  using Crypto::CppEcPrivateKey;
+  using Crypto::CppEcPublicKey;
+  using Crypto::CppInteger;
   using Utils::QRunTimeError;
 
 namespace Anonymity {
+  bool NeffKeyShuffle::_elliptic_curve = false;
+
   NeffKeyShuffle::NeffKeyShuffle(const Group &group,
       const PrivateIdentity &ident, const Id &round_id,
       QSharedPointer<Network> network,
@@ -39,6 +48,8 @@ namespace Anonymity {
     } else {
       InitClient();
     }
+
+    _state->elliptic_curve = _elliptic_curve;
   }
 
   NeffKeyShuffle::~NeffKeyShuffle()
@@ -117,8 +128,8 @@ namespace Anonymity {
 
     if(key == 0) {
       throw QRunTimeError("Received a 0 key");
-    } else if(GetModulus() <= key) {
-      throw QRunTimeError("Key is not valid in this modulus");
+    } else if(!IsValidElement(key)) {
+      throw QRunTimeError("Key is not valid in this group");
     }
     
     _server_state->shuffle_input[gidx] = key;
@@ -145,7 +156,7 @@ namespace Anonymity {
 
     stream >> generator_input >> shuffle_input;
 
-    if(generator_input == 0) {
+    if(!IsValidElement(generator_input)) {
       throw QRunTimeError("Invalid generator found");
     } else if(shuffle_input.count() < GetGroup().GetSubgroup().Count()) {
       throw QRunTimeError("Missing public keys");
@@ -172,7 +183,7 @@ namespace Anonymity {
 
     stream >> new_generator >> new_public_elements;
 
-    if(new_generator == 0) {
+    if(!IsValidElement(new_generator)) {
       throw QRunTimeError("Invalid generator found");
     } else if(new_public_elements.count() < GetGroup().GetSubgroup().Count()) {
       throw QRunTimeError("Missing public keys");
@@ -188,6 +199,13 @@ namespace Anonymity {
 
   void NeffKeyShuffle::GenerateKey()
   {
+    if(_state->elliptic_curve) {
+      _state->input_private_key = QSharedPointer<AsymmetricKey>(
+          new CppEcPrivateKey());
+      _state_machine.StateComplete();
+      return;
+    }
+
     QSharedPointer<CppDsaPrivateKey> base_key(
         CppDsaPrivateKey::GenerateKey(GetRoundId().GetByteArray()));
 
@@ -202,10 +220,7 @@ namespace Anonymity {
     QByteArray msg;
     QDataStream stream(&msg, QIODevice::WriteOnly);
 
-    QSharedPointer<CppDsaPrivateKey> key(
-        _state->input_private_key.dynamicCast<CppDsaPrivateKey>());
-    Q_ASSERT(key);
-    stream << KEY_SUBMIT << GetRoundId() << key->GetPublicElement();
+    stream << KEY_SUBMIT << GetRoundId() << GetPublicElement();
 
     VerifiableSend(GetGroup().GetSubgroup().GetId(0), msg);
     _state_machine.StateComplete();
@@ -226,15 +241,33 @@ namespace Anonymity {
   {
     _state->blame = !CheckShuffleOrder(_server_state->shuffle_input);
 
-    QSharedPointer<CppDsaPrivateKey> tmp_key(
-        new CppDsaPrivateKey(GetModulus(), GetSubgroup(), GetGenerator()));
-    _server_state->exponent = tmp_key->GetPrivateExponent();
-    _server_state->generator_output = _server_state->generator_input.Pow(
-        _server_state->exponent, GetModulus());
+    _server_state->shuffle_output.reserve(_server_state->shuffle_input.count());
 
-    foreach(const Integer &key, _server_state->shuffle_input) {
-      _server_state->shuffle_output.append(
-          key.Pow(_server_state->exponent, GetModulus()));
+    if(_state->elliptic_curve) {
+      _server_state->exponent = CppEcGroup::GetRandomExponent();
+      _server_state->generator_output = CppEcGroup::Multiply(
+          _server_state->generator_input, _server_state->exponent);
+
+      foreach(const Integer &key, _server_state->shuffle_input) {
+        _server_state->shuffle_output.append(
+            CppEcGroup::Multiply(key, _server_state->exponent));
+      }
+    } else {
+      QSharedPointer<CppDsaPrivateKey> tmp_key(
+          new CppDsaPrivateKey(GetModulus(), GetSubgroup(), GetGenerator()));
+      _server_state->exponent = tmp_key->GetPrivateExponent();
+
+      // Convert the loop invariants once and work on value-type integers, so
+      // the loop only allocates the results
+      const CppInteger modulus(GetModulus());
+      const CppInteger exponent(_server_state->exponent);
+      _server_state->generator_output = CppInteger(
+          _server_state->generator_input).Pow(exponent, modulus).ToInteger();
+
+      foreach(const Integer &key, _server_state->shuffle_input) {
+        _server_state->shuffle_output.append(
+            CppInteger(key).Pow(exponent, modulus).ToInteger());
+      }
     }
 
     qSort(_server_state->shuffle_output);
@@ -263,21 +296,33 @@ namespace Anonymity {
       return;
     }
 
-    Integer my_element = _state->new_generator.Pow(GetPrivateExponent(),
-        GetModulus());
+    Integer my_element = Exponentiate(_state->new_generator,
+        GetPrivateExponent());
 
     for(int idx = 0; idx < _state->new_public_elements.count(); idx++) {
-      if(_state->new_public_elements[idx] == my_element) {
+      const Integer &element = _state->new_public_elements[idx];
+
+      if(element == my_element) {
         _state->user_key_index = idx;
-        _state->output_private_key = QSharedPointer<AsymmetricKey>(
-            new CppDsaPrivateKey(GetModulus(), GetSubgroup(),
-              _state->new_generator, GetPrivateExponent()));
+        if(_state->elliptic_curve) {
+          _state->output_private_key = QSharedPointer<AsymmetricKey>(
+              new CppEcPrivateKey(_state->new_generator, GetPrivateExponent()));
+        } else {
+          _state->output_private_key = QSharedPointer<AsymmetricKey>(
+              new CppDsaPrivateKey(GetModulus(), GetSubgroup(),
+                _state->new_generator, GetPrivateExponent()));
+        }
         qDebug() << "Found my key at" << idx;
       }
 
-      _state->output_keys.append(QSharedPointer<AsymmetricKey>(
-            new CppDsaPublicKey(GetModulus(), GetSubgroup(),
-              _state->new_generator, _state->new_public_elements[idx]))); 
+      if(_state->elliptic_curve) {
+        _state->output_keys.append(QSharedPointer<AsymmetricKey>(
+              new CppEcPublicKey(_state->new_generator, element)));
+      } else {
+        _state->output_keys.append(QSharedPointer<AsymmetricKey>(
+              new CppDsaPublicKey(GetModulus(), GetSubgroup(),
+                _state->new_generator, element)));
+      }
     }
 
     if(_state->user_key_index == -1) {
@@ -301,6 +346,62 @@ namespace Anonymity {
     return true;
   }
 
+  void NeffKeyShuffle::SetEllipticCurve(bool elliptic_curve)
+  {
+    _elliptic_curve = elliptic_curve;
+  }
+
+  bool NeffKeyShuffle::GetEllipticCurve()
+  {
+    return _elliptic_curve;
+  }
+
+  NeffKeyShuffle::Integer NeffKeyShuffle::GetGenerator() const
+  {
+    if(_state->elliptic_curve) {
+      return _state->input_private_key.dynamicCast<CppEcPrivateKey>()->
+        GetGenerator();
+    }
+    return _state->input_private_key.dynamicCast<KeyType>()->GetGenerator();
+  }
+
+  NeffKeyShuffle::Integer NeffKeyShuffle::GetPublicElement() const
+  {
+    if(_state->elliptic_curve) {
+      return _state->input_private_key.dynamicCast<CppEcPrivateKey>()->
+        GetPublicElement();
+    }
+    return _state->input_private_key.dynamicCast<KeyType>()->GetPublicElement();
+  }
+
+  NeffKeyShuffle::Integer NeffKeyShuffle::GetPrivateExponent() const
+  {
+    if(_state->elliptic_curve) {
+      return _state->input_private_key.dynamicCast<CppEcPrivateKey>()->
+        GetPrivateExponent();
+    }
+    return _state->input_private_key.dynamicCast<KeyType>()->
+      GetPrivateExponent();
+  }
+
+  bool NeffKeyShuffle::IsValidElement(const Integer &element) const
+  {
+    if(_state->elliptic_curve) {
+      return CppEcGroup::IsElement(element);
+    }
+    return element != 0 && element < GetModulus();
+  }
+
+  NeffKeyShuffle::Integer NeffKeyShuffle::Exponentiate(const Integer &element,
+      const Integer &exponent) const
+  {
+    if(_state->elliptic_curve) {
+      return CppEcGroup::Multiply(element, exponent);
+    }
+    return CppInteger(element).Pow(CppInteger(exponent),
+        CppInteger(GetModulus())).ToInteger();
+  }
+
   void NeffKeyShuffle::ConcludeKeySubmission(const int &)
   {
     qDebug() << "Key window has closed, unfortunately some keys may not"
@@ -25,6 +25,12 @@ namespace Anonymity {
    * to the clients, who find their slot by calculating their public key via
    * y_i_k = g_k ^ x_i.
    *
+   * The members may instead use the elliptic curve group of
+   * Crypto::CppEcGroup, where the exponentiations become scalar
+   * multiplications, elements are compressed points and the anonymized keys
+   * are Crypto::CppEcPrivateKey / CppEcPublicKey keys, which have much
+   * smaller signatures than their DSA counterparts.
+   *
    * Because of the nature of this round, it is very different than other
    * protocol rounds.  There is no input and there are no automated outputs.
    * Outputs need to be explicitly taken via the objects public methods.
@@ -133,6 +139,18 @@ namespace Anonymity {
        */
       static bool CheckShuffleOrder(const QVector<Crypto::Integer> &keys);
 
+      /**
+       * Sets whether new rounds shuffle elliptic curve keys instead of DSA
+       * keys.  All members must use the same value.
+       * @param elliptic_curve true for the elliptic curve group
+       */
+      static void SetEllipticCurve(bool elliptic_curve);
+
+      /**
+       * Returns true if new rounds shuffle elliptic curve keys
+       */
+      static bool GetEllipticCurve();
+
       /**
        * Notifies the round that a peer has disconnected.  Servers require
        * restarting the round, clients are ignored
@@ -208,26 +226,23 @@ namespace Anonymity {
         return key->GetSubgroup();
       }
 
-      Integer GetGenerator() const
-      { 
-        QSharedPointer<KeyType> key(
-            _state->input_private_key.dynamicCast<KeyType>());
-        return key->GetGenerator();
-      }
+      Integer GetGenerator() const;
+      Integer GetPublicElement() const;
+      Integer GetPrivateExponent() const;
 
-      Integer GetPublicElement() const
-      { 
-        QSharedPointer<KeyType> key(
-            _state->input_private_key.dynamicCast<KeyType>());
-        return key->GetPublicElement();
-      }
+      /**
+       * Returns true if element is a usable element of the group
+       * @param element the element to check
+       */
+      bool IsValidElement(const Integer &element) const;
 
-      Integer GetPrivateExponent() const
-      { 
-        QSharedPointer<KeyType> key(
-            _state->input_private_key.dynamicCast<KeyType>());
-        return key->GetPrivateExponent();
-      }
+      /**
+       * Returns element raised to exponent in the group
+       * @param element the base
+       * @param exponent the exponent
+       */
+      Integer Exponentiate(const Integer &element,
+          const Integer &exponent) const;
 
       /**
        * Internal state
@@ -236,7 +251,8 @@ namespace Anonymity {
         public:
           State() :
             blame(false),
-            user_key_index(-1)
+            user_key_index(-1),
+            elliptic_curve(false)
           {}
 
           virtual ~State() {}
@@ -246,6 +262,7 @@ namespace Anonymity {
           QSharedPointer<AsymmetricKey> output_private_key;
           QVector<QSharedPointer<AsymmetricKey> > output_keys;
           int user_key_index;
+          bool elliptic_curve;
 
           Integer new_generator;
           QVector<Integer> new_public_elements;
@@ -275,6 +292,7 @@ namespace Anonymity {
       QSharedPointer<ServerState> _server_state;
       QSharedPointer<State> _state;
       RoundStateMachine<NeffKeyShuffle> _state_machine;
+      static bool _elliptic_curve;
   };
 }
 }
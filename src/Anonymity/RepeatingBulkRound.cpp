@@ -301,7 +301,7 @@ namespace Anonymity {
     }
 
     QSharedPointer<AsymmetricKey> verification_key(_descriptors[member_idx].second);
-    uint vkey_size = verification_key->GetKeySize() / 8;
+    uint vkey_size = verification_key->GetSignatureLength();
 
     QByteArray base = QByteArray::fromRawData(cleartext.constData(), cleartext.size() - vkey_size);
     QByteArray sig = QByteArray::fromRawData(cleartext.constData() + cleartext.size() - vkey_size, vkey_size);
@@ -437,7 +437,7 @@ namespace Anonymity {
     for(uint idx = 0; idx < count; idx++) {
       QPair<QSharedPointer<ISender>, QByteArray> pair(_shuffle_sink.At(idx));
       _descriptors.append(ParseDescriptor(pair.second));
-      _header_lengths.append(8 + (_descriptors.last().second->GetKeySize() / 8));
+      _header_lengths.append(8 + _descriptors.last().second->GetSignatureLength());
       _message_lengths.append(0);
       if(_shuffle_data == pair.second) {
         _my_idx = idx;
@@ -15,7 +15,8 @@ namespace Anonymity {
     _network(network),
     _get_data_cb(get_data),
     _successful(false),
-    _interrupted(false)
+    _interrupted(false),
+    _task_group(new Utils::TaskGroup(round_id.ToString()))
   {
   }
 
@@ -26,6 +27,13 @@ namespace Anonymity {
 
   void Round::OnStop()
   {
+    // Work still queued for the round is of no use anymore
+    _task_group->Cancel();
+    Utils::TaskStats stats = _task_group->GetStats();
+    if(stats.completed + stats.cancelled + _task_group->GetPending() > 0) {
+      qDebug() << ToString() << "crypto tasks:" << stats << "pending:" <<
+        _task_group->GetPending();
+    }
     emit Finished();
   }
 
@@ -63,7 +71,7 @@ namespace Anonymity {
       return false;
     }
 
-    int sig_size = key->GetKeySize() / 8;
+    int sig_size = key->GetSignatureLength();
     if(data.size() < sig_size) {
       qDebug() << "Received malsigned data block, not enough data blocks." <<
        "Expected at least:" << sig_size << "got" << data.size();
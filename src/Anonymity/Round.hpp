@@ -13,6 +13,7 @@
 #include "Messaging/ISender.hpp"
 #include "Messaging/SourceObject.hpp"
 #include "Utils/StartStop.hpp"
+#include "Utils/TaskScheduler.hpp"
 
 namespace Dissent {
 namespace Connections {
@@ -120,6 +121,14 @@ namespace Anonymity {
        */
       virtual void PeerJoined() {}
 
+      /**
+       * Called by the session on a new round with the round it replaces, so
+       * state meant to outlive a round, such as latency history, carries
+       * over.  Default behavior is to keep nothing.
+       * @param previous the session's previous round
+       */
+      virtual void InheritState(const Round &previous) { Q_UNUSED(previous); }
+
       /**
        * Returns true if the protocol supports nodes that have left the round
        * to rejoin.
@@ -241,6 +250,15 @@ namespace Anonymity {
 
       void SetSuccessful(bool successful) { _successful = successful; }
 
+      /**
+       * Returns the group for the round's background crypto tasks, cancelled
+       * when the round stops
+       */
+      inline QSharedPointer<Utils::TaskGroup> GetTaskGroup() const
+      {
+        return _task_group;
+      }
+
       /**
        * Returns the underlyign network
        */
@@ -283,6 +301,7 @@ namespace Anonymity {
       QVector<int> _empty_list;
       bool _interrupted;
       QWeakPointer<Round> _shared;
+      QSharedPointer<Utils::TaskGroup> _task_group;
   };
 
   inline QDebug operator<<(QDebug dbg, const QSharedPointer<Round> &round)
@@ -256,8 +256,12 @@ namespace Sessions {
 
   void Session::NextRound(const Id &round_id)
   {
+    QSharedPointer<Round> previous = _current_round;
     _current_round = _create_round(GetGroup(), GetPrivateIdentity(), round_id,
         _network, _get_data_cb);
+    if(previous) {
+      _current_round->InheritState(*previous);
+    }
 
     qDebug() << "Session" << ToString() << "preparing new round" <<
       _current_round;
@@ -77,6 +77,13 @@ namespace Sessions {
   {
     _check_log_off_event.Stop();
     _prepare_event.Stop();
+    _challenge_response_event.Stop();
+
+    foreach(const Request &request, _pending_challenge_responses) {
+      request.Failed(Response::Other, "SessionLeader stopped");
+    }
+    _pending_challenge_responses.clear();
+
     emit Stopping();
   }
 
@@ -107,9 +114,6 @@ namespace Sessions {
       return;
     }
     
-    QVariantHash req = request.GetData().toHash();
-    QVariant cresponse = req.value("challenge");
-
     Id sender_id = Connections::IOverlaySender::GetRemoteId(request.GetFrom());
     if(sender_id == Id::Zero()) {
       qDebug() << "Received a ChallengeResponse from a non-IOverlay sender";
@@ -118,28 +122,67 @@ namespace Sessions {
       return;
     }
 
-    QPair<bool, PublicIdentity> auth = _auth->VerifyResponse(sender_id, cresponse);
-    if(!auth.first) {
-      qDebug() << "Failed to authenticate.";
-      request.Failed(Response::InvalidInput, "Failed to authenticate.");
-      return;
+    // Queue the response so that a burst of joins is verified concurrently
+    _pending_challenge_responses.append(request);
+    if(_challenge_response_event.Stopped()) {
+      Dissent::Utils::TimerCallback *cb =
+        new Dissent::Utils::TimerMethod<SessionLeader, int>(this,
+            &SessionLeader::ProcessChallengeResponses, 0);
+      _challenge_response_event = Dissent::Utils::Timer::GetInstance().
+        QueueCallback(cb, ChallengeResponseBatchDelay);
     }
+  }
+
+  void SessionLeader::ProcessChallengeResponses(const int &)
+  {
+    _challenge_response_event.Stop();
 
-    if(!AllowRegistration(request.GetFrom(), auth.second)) {
-      qDebug() << "Peer," << auth.second << ", has connectivity problems," <<
-       "deferring registration until later.";
-      request.Failed(Response::Other,
-          "Unable to register at this time, try again later.");
+    QList<Request> requests = _pending_challenge_responses;
+    _pending_challenge_responses.clear();
+    if(requests.isEmpty()) {
       return;
     }
 
-    qDebug() << "Received a valid registration message from:" << auth.second;
-    _last_registration = Dissent::Utils::Time::GetInstance().CurrentTime();
+    QVector<Id> members;
+    QVector<QVariant> responses;
+    foreach(const Request &request, requests) {
+      members.append(Connections::IOverlaySender::GetRemoteId(request.GetFrom()));
+      responses.append(request.GetData().toHash().value("challenge"));
+    }
 
-    AddMember(auth.second);
-    request.Respond(true);
+    QVector<QPair<bool, PublicIdentity> > auths =
+      _auth->VerifyResponses(members, responses);
 
-    CheckRegistration();
+    bool registered = false;
+    for(int idx = 0; idx < requests.count(); idx++) {
+      const Request &request = requests[idx];
+      const QPair<bool, PublicIdentity> &auth = auths[idx];
+
+      if(!auth.first) {
+        qDebug() << "Failed to authenticate.";
+        request.Failed(Response::InvalidInput, "Failed to authenticate.");
+        continue;
+      }
+
+      if(!AllowRegistration(request.GetFrom(), auth.second)) {
+        qDebug() << "Peer," << auth.second << ", has connectivity problems," <<
+         "deferring registration until later.";
+        request.Failed(Response::Other,
+            "Unable to register at this time, try again later.");
+        continue;
+      }
+
+      qDebug() << "Received a valid registration message from:" << auth.second;
+      _last_registration = Dissent::Utils::Time::GetInstance().CurrentTime();
+
+      AddMember(auth.second);
+      request.Respond(true);
+      registered = true;
+    }
+
+    if(registered) {
+      CheckRegistration();
+    }
   }
 
   bool SessionLeader::AllowRegistration(const QSharedPointer<ISender> &,
@@ -133,6 +133,12 @@ namespace Sessions {
 
       static bool EnableLogOffMonitor;
 
+      /**
+       * Delay before verifying queued challenge responses, responses that
+       * arrive within this window are verified together as a batch
+       */
+      static const int ChallengeResponseBatchDelay = 0;
+
       inline const Id &GetSessionId() const { return _session->GetSessionId(); }
 
     signals:
@@ -219,6 +225,13 @@ namespace Sessions {
        */
       void CheckLogOffTimes(const int &);
 
+      /**
+       * Verifies all queued challenge responses as a single batch and
+       * registers the members that authenticated
+       * @param unused
+       */
+      void ProcessChallengeResponses(const int &);
+
       /**
        * Checks to see if the leader has received all the Ready messsages and
        * broadcasts responses if it has.
@@ -248,6 +261,8 @@ namespace Sessions {
       QDateTime _last_registration;
       Utils::TimerEvent _prepare_event;
       Utils::TimerEvent _check_log_off_event;
+      Utils::TimerEvent _challenge_response_event;
+      QList<Request> _pending_challenge_responses;
       QHash<Id, Id> _registered_peers;
       QList<Id> _prepared_peers;
       QHash<Id, Id> _unprepared_peers;
@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <QAtomicInt>
 #include <QDebug>
+#include <QRunnable>
 
 #include "Utils/QRunTimeError.hpp"
+#include "Utils/TaskScheduler.hpp"
 #include "Crypto/CryptoFactory.hpp"
 
 #include "ShuffleBlamer.hpp"
@@ -11,6 +15,40 @@ using Dissent::Crypto::OnionEncryptor;
 
 namespace Dissent {
 namespace Anonymity {
+namespace {
+  /**
+   * Replays logs until none are left, taking the next unclaimed log each
+   * time since shuffler logs take far longer than the rest
+   */
+  class ReplayTask : public QRunnable {
+    public:
+      typedef void (ShuffleBlamer::*Replay)(int, QVector<QString> &) const;
+
+      ReplayTask(const ShuffleBlamer &blamer, Replay replay, int count,
+          QAtomicInt &next, QVector<QString> *errors) :
+        _blamer(blamer), _replay(replay), _count(count), _next(next),
+        _errors(errors)
+      {
+      }
+
+      virtual void run()
+      {
+        for(int idx = _next.fetchAndAddOrdered(1); idx < _count;
+            idx = _next.fetchAndAddOrdered(1))
+        {
+          (_blamer.*_replay)(idx, _errors[idx]);
+        }
+      }
+
+    private:
+      const ShuffleBlamer &_blamer;
+      Replay _replay;
+      int _count;
+      QAtomicInt &_next;
+      QVector<QString> *_errors;
+  };
+}
+
   ShuffleBlamer::ShuffleBlamer(const Group &group,
       const Id &round_id,
       const QVector<Log> &logs,
@@ -54,10 +92,10 @@ namespace Anonymity {
     _set = true;
   }
 
-  void ShuffleBlamer::Start()
+  void ShuffleBlamer::Start(int threads)
   {
     qDebug() << "Blame: Parsing logs";
-    ParseLogs();
+    ParseLogs(threads);
     qDebug() << "Blame: Checking public keys";
     CheckPublicKeys();
     if(!_set) {
@@ -77,17 +115,51 @@ namespace Anonymity {
     return _reasons[idx];
   }
 
-  void ShuffleBlamer::ParseLogs()
+  void ShuffleBlamer::ParseLogs(int threads)
   {
-    for(int idx = 0; idx < _logs.count(); idx++) {
-      ParseLog(idx);
+    int count = _logs.count();
+    QVector<QVector<QString> > errors(count);
+
+    if(threads <= 0) {
+      threads = CryptoFactory::GetInstance().GetThreadCount();
+    }
+    threads = std::min(threads, count);
+
+    // Each replay only touches its own round, its own log and thread local
+    // crypto state (the pooled RNG and thread hash), so replays can run
+    // side by side.  The calling thread replays too, the scheduler is
+    // dedicated so that crypto calls made during replay cannot wait on
+    // themselves.
+    QAtomicInt next(0);
+    ReplayTask replay(*this, &ShuffleBlamer::ParseLog, count, next,
+        errors.data());
+    replay.setAutoDelete(false);
+
+    if(threads <= 1) {
+      replay.run();
+    } else {
+      Utils::TaskScheduler scheduler(threads - 1);
+      for(int idx = 1; idx < threads; idx++) {
+        ReplayTask *task = new ReplayTask(*this, &ShuffleBlamer::ParseLog,
+            count, next, errors.data());
+        scheduler.Start(task, Utils::TaskScheduler::Critical);
+      }
+      replay.run();
+      scheduler.WaitForDone();
+    }
+
+    // Merge in member order, so the outcome does not depend on scheduling
+    for(int idx = 0; idx < count; idx++) {
+      foreach(const QString &error, errors[idx]) {
+        Set(idx, error);
+      }
     }
   }
 
-  void ShuffleBlamer::ParseLog(int idx)
+  void ShuffleBlamer::ParseLog(int idx, QVector<QString> &errors) const
   {
-    Log &clog = _logs[idx];
-    ShuffleRoundBlame *round = _rounds[idx];
+    Log clog = _logs.at(idx);
+    ShuffleRoundBlame *round = _rounds.at(idx);
     round->Start();
 
     for(int jdx = 0; jdx < clog.Count(); jdx++) {
@@ -100,7 +172,7 @@ namespace Anonymity {
           _group.GetIndex(entry.second) << "in state" <<
           ShuffleRound::StateToString(round->GetState()) <<
           "causing the following exception: " << err.What();
-        Set(idx, err.What());
+        errors.append(err.What());
       }
     }
   }
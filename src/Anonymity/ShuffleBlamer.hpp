@@ -45,9 +45,12 @@ namespace Anonymity {
       ~ShuffleBlamer();
 
       /**
-       * Start the blame process
+       * Start the blame process, each member's log is replayed concurrently
+       * and any faults are recorded in member order once all are done
+       * @param threads the amount of replays run at once, 0 uses the
+       * CryptoFactory thread count
        */
-      void Start();
+      void Start(int threads = 0);
 
       /**
        * Returns a bit array, an index is true if the node was bad
@@ -76,15 +79,18 @@ namespace Anonymity {
       void Set(int idx, const QString &reason);
       
       /**
-       * Creates Shuffle rounds using the ShuffleRoundBlame for each given log
+       * Replays each given log into its ShuffleRoundBlame
+       * @param threads the amount of replays run at once
        */
-      void ParseLogs();
+      void ParseLogs(int threads);
 
       /**
-       * Creates a ShuffleRoundBlame for the given node idx
+       * Replays the log of the given node idx into its ShuffleRoundBlame,
+       * safe to call concurrently for different nodes
        * @param idx the log to parse
+       * @param errors returns the exceptions raised by the log's messages
        */
-      void ParseLog(int idx);
+      void ParseLog(int idx, QVector<QString> &errors) const;
 
       /**
        * Verifies that each node has the correct public keys
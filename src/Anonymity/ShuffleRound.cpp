@@ -1,4 +1,4 @@
-#include <QRunnable>
+#include <QHash>
 
 #include "Crypto/CryptoFactory.hpp"
 #include "Utils/Serialization.hpp"
@@ -22,6 +22,8 @@ using namespace ShuffleRoundPrivate;
 
   const QByteArray ShuffleRound::DefaultData = QByteArray(ShuffleRound::BlockSize + 4, 0);
 
+  int ShuffleRound::_shuffle_chunk_size = 0;
+
   ShuffleRound::ShuffleRound(const Group &group,
       const PrivateIdentity &ident, const Id &round_id,
       QSharedPointer<Network> network, GetDataCallback &get_data) :
@@ -95,7 +97,7 @@ using namespace ShuffleRoundPrivate;
           &ShuffleRound::HandleData, &ShuffleRound::PrepareForInitialData);
     } else {
       _state_machine.AddState(WAITING_FOR_SHUFFLE, SHUFFLE_DATA,
-          &ShuffleRound::HandleShuffle);
+          &ShuffleRound::HandleShuffle, &ShuffleRound::PrepareForShuffle);
     }
 
     _state_machine.AddState(SHUFFLING, -1, 0, &ShuffleRound::Shuffle);
@@ -165,6 +167,20 @@ using namespace ShuffleRoundPrivate;
   {
   }
 
+  void ShuffleRound::SetShuffleChunkSize(int size)
+  {
+    if(size < 0) {
+      qCritical() << "Invalid shuffle chunk size:" << size;
+      size = 0;
+    }
+    _shuffle_chunk_size = size;
+  }
+
+  int ShuffleRound::GetShuffleChunkSize()
+  {
+    return _shuffle_chunk_size;
+  }
+
   QByteArray ShuffleRound::PrepareData()
   {
     QPair<QByteArray, bool> data = GetData(BlockSize);
@@ -269,6 +285,7 @@ using namespace ShuffleRoundPrivate;
 
     _server_state->shuffle_input[gidx] = data;
     ++_server_state->data_received;
+    DecryptAhead(gidx, gidx + 1);
 
     qDebug() << GetGroup().GetIndex(GetLocalId()) << GetLocalId() <<
         ": received initial data from" << GetGroup().GetIndex(id) << id <<
@@ -285,12 +302,44 @@ using namespace ShuffleRoundPrivate;
       throw QRunTimeError("Received a shuffle out of order");
     }
 
-    stream >> _server_state->shuffle_input;
+    int offset, total;
+    QVector<QByteArray> chunk;
+    stream >> offset >> total >> chunk;
+
+    if(_server_state->shuffle_total == -1) {
+      if(total < 0 || total > GetGroup().Count()) {
+        throw QRunTimeError("Received a shuffle of invalid size");
+      }
+      _server_state->shuffle_total = total;
+      _server_state->shuffle_input = QVector<QByteArray>(total);
+    } else if(total != _server_state->shuffle_total) {
+      throw QRunTimeError("Received shuffle chunks of differing sizes");
+    }
+
+    if(offset != _server_state->shuffle_received ||
+        (chunk.isEmpty() && total != 0) ||
+        chunk.count() > total - offset)
+    {
+      throw QRunTimeError("Received a shuffle chunk out of order");
+    }
+
+    for(int idx = 0; idx < chunk.count(); idx++) {
+      _server_state->shuffle_input[offset + idx] = chunk[idx];
+    }
+    _server_state->shuffle_received += chunk.count();
 
     qDebug() << GetGroup().GetIndex(GetLocalId()) << GetLocalId() <<
-        ": received shuffle data from" << GetGroup().GetIndex(id) << id;
+        ": received shuffle data from" << GetGroup().GetIndex(id) << id <<
+        "Have:" << _server_state->shuffle_received << "expect:" << total;
 
-    _state_machine.StateComplete();
+    // An unchunked shuffle is decrypted by Shuffle right away
+    if(chunk.count() < total) {
+      DecryptAhead(offset, offset + chunk.count());
+    }
+
+    if(_server_state->shuffle_received == total) {
+      _state_machine.StateComplete();
+    }
   }
 
   void ShuffleRound::HandleDataBroadcast(const Id &id, QDataStream &stream)
@@ -520,48 +569,163 @@ using namespace ShuffleRoundPrivate;
     _server_state->shuffle_input = QVector<QByteArray>(GetGroup().Count());
   }
 
-  void ShuffleRound::Shuffle()
+  void ShuffleRound::PrepareForShuffle()
   {
-    for(int idx = 0; idx < _server_state->shuffle_input.count(); idx++) {
-      for(int jdx = 0; jdx < _server_state->shuffle_input.count(); jdx++) {
-        if(idx == jdx) {
-          continue;
-        }
-        if(_server_state->shuffle_input[idx] != _server_state->shuffle_input[jdx]) {
-          continue;
-        }
-        qWarning() << "Found duplicate cipher texts... setting blame";
-        _state->blame = true;
-        break;
-      }
+    _server_state->shuffle_input.clear();
+    _server_state->shuffle_received = 0;
+    _server_state->shuffle_total = -1;
+  }
+
+  void ShuffleRound::DecryptAhead(int start, int end)
+  {
+    for(int idx = start; idx < end; idx++) {
+      _server_state->decrypt_pending.append(idx);
     }
 
-    QVector<int> bad;
+    // Wait for enough input to keep every crypto thread busy, single
+    // messages would otherwise be decrypted inline on the event loop
+    int threads = CryptoFactory::GetInstance().GetThreadCount();
+    if(_server_state->decrypt_pending.count() < threads) {
+      return;
+    }
+
+    int count = _server_state->shuffle_input.count();
+    if(_server_state->decrypted_input.count() != count) {
+      _server_state->decrypted_input = QVector<QByteArray>(count);
+      _server_state->decrypted_output = QVector<QByteArray>(count);
+      _server_state->decrypted_digests = QVector<QByteArray>(count);
+    }
+
+    const QVector<int> &pending = _server_state->decrypt_pending;
+    QVector<QByteArray> input;
+    foreach(int idx, pending) {
+      input.append(_server_state->shuffle_input[idx]);
+    }
+
+    QVector<QByteArray> output, digests;
     OnionEncryptor *oe = CryptoFactory::GetInstance().GetOnionEncryptor();
-    if(!oe->Decrypt(_server_state->outer_key, _server_state->shuffle_input,
-          _server_state->shuffle_output, &bad))
-    {
-      qWarning() << _shufflers.GetIndex(GetLocalId()) <<
-        GetGroup().GetIndex(GetLocalId()) << GetLocalId() <<
-        ": failed to decrypt layer due to block at indexes" << bad;
-      _state->blame = true;
+    oe->DecryptWithDigests(_server_state->outer_key, input, output, digests, 0);
+
+    for(int idx = 0; idx < input.count(); idx++) {
+      _server_state->decrypted_input[pending[idx]] = input[idx];
+      _server_state->decrypted_output[pending[idx]] = output[idx];
+      _server_state->decrypted_digests[pending[idx]] = digests[idx];
     }
+    _server_state->decrypt_pending.clear();
+  }
 
-    oe->RandomizeBlocks(_server_state->shuffle_output);
+  bool ShuffleRound::DecryptShuffleInput(QVector<int> &bad,
+      QVector<QByteArray> &digests)
+  {
+    const QVector<QByteArray> &input = _server_state->shuffle_input;
+    QVector<QByteArray> &output = _server_state->shuffle_output;
+    output = QVector<QByteArray>(input.count());
+    digests = QVector<QByteArray>(input.count());
+
+    // Anything changed or not seen by DecryptAhead is decrypted now
+    QVector<int> remaining;
+    QVector<QByteArray> remaining_input;
+    bool ahead = _server_state->decrypted_input.count() == input.count();
+    for(int idx = 0; idx < input.count(); idx++) {
+      if(ahead && !input[idx].isEmpty() &&
+          _server_state->decrypted_input[idx] == input[idx])
+      {
+        output[idx] = _server_state->decrypted_output[idx];
+        digests[idx] = _server_state->decrypted_digests[idx];
+      } else {
+        remaining.append(idx);
+        remaining_input.append(input[idx]);
+      }
+    }
 
-    const Id &next = _shufflers.Next(GetLocalId());
-    MessageType mtype = (next == Id::Zero()) ? ENCRYPTED_DATA : SHUFFLE_DATA;
+    if(!remaining.isEmpty()) {
+      QVector<QByteArray> remaining_output, remaining_digests;
+      OnionEncryptor *oe = CryptoFactory::GetInstance().GetOnionEncryptor();
+      oe->DecryptWithDigests(_server_state->outer_key, remaining_input,
+          remaining_output, remaining_digests, 0);
+      for(int idx = 0; idx < remaining.count(); idx++) {
+        output[remaining[idx]] = remaining_output[idx];
+        digests[remaining[idx]] = remaining_digests[idx];
+      }
+    }
 
-    QByteArray msg;
-    QDataStream out_stream(&msg, QIODevice::WriteOnly);
-    out_stream << mtype << GetRoundId() << _server_state->shuffle_output;
+    _server_state->decrypted_input.clear();
+    _server_state->decrypted_output.clear();
+    _server_state->decrypted_digests.clear();
+    _server_state->decrypt_pending.clear();
 
-    if(mtype == ENCRYPTED_DATA) {
+    for(int idx = 0; idx < output.count(); idx++) {
+      if(output[idx].isEmpty()) {
+        bad.append(idx);
+      }
+    }
+    return bad.isEmpty();
+  }
+
+  bool ShuffleRound::HasDuplicateInput(const QVector<QByteArray> &digests) const
+  {
+    const QVector<QByteArray> &input = _server_state->shuffle_input;
+    QHash<QByteArray, int> seen;
+    seen.reserve(digests.count());
+
+    for(int idx = 0; idx < digests.count(); idx++) {
+      QHash<QByteArray, int>::const_iterator it = seen.constFind(digests[idx]);
+      // Confirm matches, a digest collision should not cause blame
+      if(it != seen.constEnd() && input[it.value()] == input[idx]) {
+        return true;
+      }
+      seen.insert(digests[idx], idx);
+    }
+    return false;
+  }
+
+  void ShuffleRound::SendShuffleOutput()
+  {
+    const QVector<QByteArray> &output = _server_state->shuffle_output;
+    const Id &next = _shufflers.Next(GetLocalId());
+
+    if(next == Id::Zero()) {
+      QByteArray msg;
+      QDataStream out_stream(&msg, QIODevice::WriteOnly);
+      out_stream << ENCRYPTED_DATA << GetRoundId() << output;
       VerifiableBroadcast(msg);
-    } else {
+      return;
+    }
+
+    int total = output.count();
+    int chunk_size = _shuffle_chunk_size > 0 ? _shuffle_chunk_size : total;
+    int offset = 0;
+
+    do {
+      QByteArray msg;
+      QDataStream out_stream(&msg, QIODevice::WriteOnly);
+      out_stream << SHUFFLE_DATA << GetRoundId() << offset << total <<
+        output.mid(offset, chunk_size);
       VerifiableSend(next, msg);
+      offset += chunk_size;
+    } while(offset < total);
+  }
+
+  void ShuffleRound::Shuffle()
+  {
+    QVector<int> bad;
+    QVector<QByteArray> digests;
+    if(!DecryptShuffleInput(bad, digests)) {
+      qWarning() << _shufflers.GetIndex(GetLocalId()) <<
+        GetGroup().GetIndex(GetLocalId()) << GetLocalId() <<
+        ": failed to decrypt layer due to block at indexes" << bad;
+      _state->blame = true;
+    }
+
+    if(HasDuplicateInput(digests)) {
+      qWarning() << "Found duplicate cipher texts... setting blame";
+      _state->blame = true;
     }
 
+    OnionEncryptor *oe = CryptoFactory::GetInstance().GetOnionEncryptor();
+    oe->RandomizeBlocks(_server_state->shuffle_output);
+
+    SendShuffleOutput();
     _state_machine.StateComplete();
   }
 
@@ -632,12 +796,18 @@ using namespace ShuffleRoundPrivate;
         SIGNAL(Finished(const QVector<QByteArray> &, const QVector<int> &)),
         this,
         SLOT(DecryptDone(const QVector<QByteArray> &, const QVector<int> &)), Qt::QueuedConnection);
-    QThreadPool::globalInstance()->start(decryptor);
+    CryptoFactory::GetInstance().GetScheduler().Start(decryptor,
+        Utils::TaskScheduler::Normal, GetTaskGroup());
   }
 
   void ShuffleRound::DecryptDone(const QVector<QByteArray> &cleartexts,
       const QVector<int> &bad)
   {
+    if(Stopped()) {
+      qDebug() << ToString() << "decryption finished after the round stopped";
+      return;
+    }
+
     if(!bad.isEmpty()) {
       qWarning() << GetGroup().GetIndex(GetLocalId()) << GetLocalId() <<
         ": failed to decrypt final layers due to block at index" << bad;
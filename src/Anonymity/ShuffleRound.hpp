@@ -4,6 +4,7 @@
 #include <QBitArray>
 #include <QDataStream>
 #include <QMetaEnum>
+#include <QRunnable>
 #include <QSharedPointer>
 
 #include "Connections/Network.hpp"
@@ -27,7 +28,9 @@ namespace Anonymity {
    * smallest largest in Integer format.  The resulting message is sent to the
    * first member in the shufflers group.  Each shuffler removes their outer
    * encryption, shuffles (permutes) the message order, and transmits the
-   * resulting message to the next member.  When the last shuffler completes
+   * resulting message to the next member, optionally in chunks so that the
+   * next member can begin decrypting before the whole set has arrived (see
+   * SetShuffleChunkSize).  When the last shuffler completes
    * their decryption and permutation, the message is broadcasted to all
    * members in the group.
    *
@@ -168,6 +171,20 @@ namespace Anonymity {
 
       inline virtual QString ToString() const { return "ShuffleRound: " + GetRoundId().ToString(); }
 
+      /**
+       * Sets the amount of messages a shuffler places in each SHUFFLE_DATA
+       * message, letting the next shuffler decrypt early chunks while the
+       * rest are still in flight.  Receivers accept any chunking, so members
+       * need not agree on the value.
+       * @param size messages per chunk, 0 sends the whole shuffle at once
+       */
+      static void SetShuffleChunkSize(int size);
+
+      /**
+       * Returns the amount of messages per shuffle chunk, 0 if unchunked
+       */
+      static int GetShuffleChunkSize();
+
     protected:
       typedef QPair<QVector<QByteArray>, QVector<QByteArray> > HashSig;
 
@@ -207,6 +224,36 @@ namespace Anonymity {
        */
       void HandleShuffle(const Id &id, QDataStream &stream);
 
+      /**
+       * Removes the local outer layer from shuffle input as it arrives, so
+       * that Shuffle only decrypts whatever has not been seen yet.  Input is
+       * batched until there is at least one message per crypto thread.
+       * @param start the first index of the newly received input
+       * @param end one past the last index of the newly received input
+       */
+      virtual void DecryptAhead(int start, int end);
+
+      /**
+       * Removes the outer layer from the entire shuffle input into the
+       * shuffle output, reusing the results of DecryptAhead for unchanged
+       * input.  Returns false and sets bad if any message fails to decrypt.
+       * @param bad returns the indexes of malformed messages
+       * @param digests returns the digest of each input ciphertext
+       */
+      bool DecryptShuffleInput(QVector<int> &bad, QVector<QByteArray> &digests);
+
+      /**
+       * Returns true if the shuffle input contains the same ciphertext twice
+       * @param digests the digest of each input ciphertext
+       */
+      bool HasDuplicateInput(const QVector<QByteArray> &digests) const;
+
+      /**
+       * Sends the shuffle output to the next shuffler in chunks or
+       * broadcasts it if this is the last shuffler
+       */
+      void SendShuffleOutput();
+
       /**
        * The inner encrypted only messages sent by the last peer
        * @param id the remote peer sending the message
@@ -308,7 +355,9 @@ namespace Anonymity {
        */
       class ServerState : public State {
         public:
-          ServerState()
+          ServerState() :
+            shuffle_received(0),
+            shuffle_total(-1)
           { }
 
           virtual ~ServerState() {}
@@ -317,6 +366,15 @@ namespace Anonymity {
           QSharedPointer<AsymmetricKey> outer_key;
           QVector<QByteArray> shuffle_input;
           QVector<QByteArray> shuffle_output;
+
+          // Input decrypted ahead of Shuffle and the resulting cleartext
+          QVector<QByteArray> decrypted_input;
+          QVector<QByteArray> decrypted_output;
+          QVector<QByteArray> decrypted_digests;
+          // Received input not yet decrypted ahead
+          QVector<int> decrypt_pending;
+          int shuffle_received;
+          int shuffle_total;
       };
 
       QSharedPointer<ServerState> _server_state;
@@ -329,6 +387,7 @@ namespace Anonymity {
       virtual void GenerateCiphertext();
       virtual void SubmitCiphertext();
       virtual void PrepareForInitialData();
+      virtual void PrepareForShuffle();
       virtual void Shuffle();
       virtual void VerifyInnerCiphertext();
       virtual void BroadcastPrivateKey();
@@ -356,6 +415,8 @@ namespace Anonymity {
 
       void EmptyTransitionCallback() {}
 
+      static int _shuffle_chunk_size;
+
       static void RegisterMetaTypes()
       {
         static bool registered = false;
@@ -90,6 +90,11 @@ namespace Anonymity {
       virtual inline void VerifiableBroadcast(const QByteArray &) {}
       virtual inline void VerifiableSend(const QByteArray &, const Id &) {}
 
+      /**
+       * Replays decrypt the whole input in Shuffle, nothing to do ahead
+       */
+      virtual inline void DecryptAhead(int, int) {}
+
       virtual void BroadcastPublicKeys();
       virtual void GenerateCiphertext();
       virtual void SubmitCiphertext();
@@ -0,0 +1,159 @@
+#include <math.h>
+#include <algorithm>
+
+#include "SubmissionDeadline.hpp"
+
+namespace Dissent {
+namespace Anonymity {
+  const double SubmissionDeadline::DEFAULT_PERCENTILE = .99;
+  const double SubmissionDeadline::DEFAULT_MULTIPLIER = 2.0;
+  const double SubmissionDeadline::DEFAULT_DECAY = .8;
+
+  SubmissionDeadline::SubmissionDeadline(qint64 min_window,
+      qint64 max_window, double percentile, double multiplier, double decay) :
+    _min_window(min_window),
+    _max_window(std::max(min_window, max_window)),
+    _percentile(percentile),
+    _multiplier(multiplier),
+    _decay(decay),
+    _histogram(BUCKETS, 0),
+    _total_weight(0),
+    _censored_weight(0),
+    _last_duration(0),
+    _last_excluded(0),
+    _total_excluded(0),
+    _phases(0)
+  {
+  }
+
+  int SubmissionDeadline::ToBucket(qint64 latency)
+  {
+    if(latency < 1) {
+      return 0;
+    }
+    int bucket = int(log(double(latency)) / log(2.0) * BUCKETS_PER_OCTAVE) + 1;
+    return std::min(bucket, BUCKETS - 1);
+  }
+
+  qint64 SubmissionDeadline::FromBucket(int bucket)
+  {
+    if(bucket == 0) {
+      return 0;
+    }
+    // Upper edge of the bucket, so percentiles err on the side of waiting
+    return qint64(ceil(pow(2.0, double(bucket) / BUCKETS_PER_OCTAVE)));
+  }
+
+  void SubmissionDeadline::AddArrival(const Id &client, qint64 latency)
+  {
+    latency = std::max(latency, qint64(0));
+    _histogram[ToBucket(latency)] += 1;
+    _total_weight += 1;
+    UpdateClient(client, latency);
+  }
+
+  void SubmissionDeadline::UpdateClient(const Id &client, qint64 latency)
+  {
+    if(_client_latencies.contains(client)) {
+      double &average = _client_latencies[client];
+      average = _decay * average + (1 - _decay) * latency;
+    } else {
+      _client_latencies[client] = latency;
+    }
+  }
+
+  void SubmissionDeadline::PhaseFinished(qint64 duration,
+      const QList<Id> &excluded, qint64 deadline)
+  {
+    // Excluded clients took at least the deadline, leaving them out would
+    // bias the percentile low and ratchet the deadline down.  Recording them
+    // at the deadline would scale it up again next phase, so only their
+    // weight counts.
+    deadline = std::max(deadline, duration);
+    foreach(const Id &client, excluded) {
+      UpdateClient(client, deadline);
+    }
+    _censored_weight += excluded.count();
+
+    _last_duration = duration;
+    _last_excluded = excluded.count();
+    _total_excluded += excluded.count();
+    _phases++;
+
+    for(int idx = 0; idx < _histogram.size(); idx++) {
+      _histogram[idx] *= _decay;
+    }
+    _total_weight *= _decay;
+    _censored_weight *= _decay;
+  }
+
+  void SubmissionDeadline::RetainClients(const QSet<Id> &clients)
+  {
+    QHash<Id, double>::iterator it = _client_latencies.begin();
+    while(it != _client_latencies.end()) {
+      if(clients.contains(it.key())) {
+        ++it;
+      } else {
+        it = _client_latencies.erase(it);
+      }
+    }
+  }
+
+  qint64 SubmissionDeadline::GetPercentile(double percentile) const
+  {
+    if(_total_weight <= 0) {
+      return -1;
+    }
+
+    double target = percentile * (_total_weight + _censored_weight);
+    double sum = 0;
+    int last = 0;
+    for(int idx = 0; idx < _histogram.size(); idx++) {
+      if(_histogram[idx] <= 0) {
+        continue;
+      }
+      sum += _histogram[idx];
+      last = idx;
+      if(sum >= target) {
+        return FromBucket(idx);
+      }
+    }
+    // Falls among censored clients, the most we know is that they were
+    // slower than everyone observed
+    return FromBucket(last);
+  }
+
+  qint64 SubmissionDeadline::GetHardDeadline() const
+  {
+    qint64 latency = GetPercentile(_percentile);
+    if(latency < 0) {
+      return _max_window;
+    }
+
+    qint64 window = qint64(latency * _multiplier);
+    return std::min(std::max(window, _min_window), _max_window);
+  }
+
+  qint64 SubmissionDeadline::GetFlexWindow(qint64 elapsed) const
+  {
+    elapsed = std::max(elapsed, qint64(0));
+    qint64 latency = GetPercentile(_percentile);
+    if(latency < 0) {
+      return std::max(elapsed, _min_window);
+    }
+
+    // Wait for the stragglers history suggests exist, but no longer than the
+    // time the majority took, and always give them the minimum window
+    qint64 window = std::min(qint64(latency * _multiplier) - elapsed, elapsed);
+    return std::max(window, _min_window);
+  }
+
+  qint64 SubmissionDeadline::GetClientLatency(const Id &client) const
+  {
+    if(!_client_latencies.contains(client)) {
+      return -1;
+    }
+    return qint64(_client_latencies[client]);
+  }
+}
+}
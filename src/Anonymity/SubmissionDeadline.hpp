@@ -0,0 +1,157 @@
+#ifndef DISSENT_ANONYMITY_SUBMISSION_DEADLINE_H_GUARD
+#define DISSENT_ANONYMITY_SUBMISSION_DEADLINE_H_GUARD
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVector>
+
+#include "Connections/Id.hpp"
+
+namespace Dissent {
+namespace Anonymity {
+  /**
+   * Chooses client submission deadlines from the observed arrival latencies
+   * of client ciphertexts.  Latencies are kept in an exponentially decayed
+   * histogram with logarithmically sized buckets, so recent phases dominate
+   * and a single slow phase is forgotten after a few phases.  The hard
+   * deadline is a multiple of a high percentile of that distribution,
+   * clamped to a configured range.  Clients that miss a phase are censored
+   * samples: all we learn is that they were slower than every client that
+   * arrived, so they add weight above the observed latencies rather than a
+   * sample at the deadline.  That keeps the estimate from drifting below
+   * the clients it excluded without feeding the deadline back into itself,
+   * which would grow it phase after phase for a client that never arrives.
+   * The flex deadline, started once most clients have submitted, waits until
+   * the same percentile rather than simply as long again, but never less
+   * than the minimum window.  Also tracks per-client latencies and per-phase
+   * metrics.  Meant to outlive a single round, so history carries across
+   * round restarts.
+   */
+  class SubmissionDeadline {
+    public:
+      typedef Connections::Id Id;
+
+      /**
+       * Constructor
+       * @param min_window the smallest hard deadline and flex window in ms
+       * @param max_window the largest hard deadline in ms, also used before
+       * any history exists
+       * @param percentile the fraction of arrivals the deadline should
+       * accommodate
+       * @param multiplier slack applied to the percentile latency
+       * @param decay weight kept by older samples after each phase
+       */
+      explicit SubmissionDeadline(qint64 min_window, qint64 max_window,
+          double percentile = DEFAULT_PERCENTILE,
+          double multiplier = DEFAULT_MULTIPLIER,
+          double decay = DEFAULT_DECAY);
+
+      /**
+       * Records a client ciphertext arriving latency ms into a phase
+       * @param client the submitting client
+       * @param latency time since the start of the phase
+       */
+      void AddArrival(const Id &client, qint64 latency);
+
+      /**
+       * Records the end of the client submission window, ages the history
+       * @param duration length of the submission window in ms
+       * @param excluded clients that did not submit in time, recorded as
+       * censored samples
+       * @param deadline the hard deadline of the phase in ms
+       */
+      void PhaseFinished(qint64 duration, const QList<Id> &excluded,
+          qint64 deadline);
+
+      /**
+       * Forgets the latencies of clients no longer in the roster
+       * @param clients the current roster
+       */
+      void RetainClients(const QSet<Id> &clients);
+
+      /**
+       * Returns the hard deadline for the next phase in ms
+       */
+      qint64 GetHardDeadline() const;
+
+      /**
+       * Returns how much longer to wait for the remaining clients once the
+       * flex threshold has been reached
+       * @param elapsed time since the start of the phase
+       */
+      qint64 GetFlexWindow(qint64 elapsed) const;
+
+      /**
+       * Returns the latency at the given percentile or -1 without history.
+       * If the percentile falls among excluded clients, returns the highest
+       * observed latency.
+       * @param percentile a value between 0 and 1
+       */
+      qint64 GetPercentile(double percentile) const;
+
+      /**
+       * Returns the decayed average latency of a client, -1 if unknown
+       * @param client the client
+       */
+      qint64 GetClientLatency(const Id &client) const;
+
+      /**
+       * Returns the duration of the last submission window
+       */
+      inline qint64 GetLastPhaseDuration() const { return _last_duration; }
+
+      /**
+       * Returns the amount of clients excluded from the last phase
+       */
+      inline int GetLastExcluded() const { return _last_excluded; }
+
+      /**
+       * Returns the amount of clients excluded across all phases
+       */
+      inline int GetTotalExcluded() const { return _total_excluded; }
+
+      /**
+       * Returns the amount of phases recorded
+       */
+      inline int GetPhaseCount() const { return _phases; }
+
+      static const double DEFAULT_PERCENTILE;
+      static const double DEFAULT_MULTIPLIER;
+      static const double DEFAULT_DECAY;
+
+      /**
+       * Histogram buckets per doubling of latency
+       */
+      static const int BUCKETS_PER_OCTAVE = 4;
+
+      /**
+       * Histogram buckets, covers up to 2^32 ms
+       */
+      static const int BUCKETS = 32 * BUCKETS_PER_OCTAVE;
+
+    private:
+      static int ToBucket(qint64 latency);
+      static qint64 FromBucket(int bucket);
+      void UpdateClient(const Id &client, qint64 latency);
+
+      qint64 _min_window;
+      qint64 _max_window;
+      double _percentile;
+      double _multiplier;
+      double _decay;
+
+      QVector<double> _histogram;
+      double _total_weight;
+      double _censored_weight;
+      QHash<Id, double> _client_latencies;
+
+      qint64 _last_duration;
+      int _last_excluded;
+      int _total_excluded;
+      int _phases;
+  };
+}
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include "Crypto/Hash.hpp"
 #include "Crypto/Library.hpp"
 #include "Crypto/Serialization.hpp"
+#include "Crypto/SharedSecretCache.hpp"
 #include "Messaging/Request.hpp"
 #include "Utils/QRunTimeError.hpp"
 #include "Utils/Random.hpp"
@@ -16,7 +17,9 @@
 
 using Dissent::Crypto::CryptoFactory;
 using Dissent::Crypto::DiffieHellman;
+using Dissent::Crypto::KeystreamGenerator;
 using Dissent::Crypto::Library;
+using Dissent::Crypto::SharedSecretCache;
 using Dissent::Utils::QRunTimeError;
 using Dissent::Utils::Random;
 using Dissent::Utils::Serialization;
@@ -56,14 +59,31 @@ namespace Tolerant {
     headers["round"] = Header_Bulk;
     GetNetwork()->SetHeaders(headers);
 
-    // Get shared secrets with servers
+    // Get shared secrets with everyone at once, the raw secrets carry over
+    // from earlier rounds with the same keys
+    const Group users = GetGroup();
+    QVector<QByteArray> user_pks;
+    for(int user_idx=0; user_idx<users.Count(); user_idx++) {
+      user_pks.append(users.GetPublicDiffieHellman(user_idx));
+    }
+
+    const DiffieHellman &dh_key = *ident.GetDhKey();
+    SharedSecretCache::Retain(dh_key, user_pks);
+
     const Group servers = GetGroup().GetSubgroup();
+    QVector<QByteArray> server_pks;
     for(int server_idx=0; server_idx<servers.Count(); server_idx++) {
-      QByteArray server_pk = servers.GetPublicDiffieHellman(server_idx);
-      QByteArray secret = ident.GetDhKey()->GetSharedSecret(server_pk);
+      server_pks.append(servers.GetPublicDiffieHellman(server_idx));
+    }
+
+    QVector<QByteArray> server_secrets =
+      SharedSecretCache::GetSharedSecrets(dh_key, server_pks);
+    for(int server_idx=0; server_idx<servers.Count(); server_idx++) {
+      QByteArray secret = server_secrets[server_idx];
 
       _secrets_with_servers[server_idx] = secret;
-      _rngs_with_servers[server_idx] = QSharedPointer<Random>(_crypto_lib->GetRandomNumberGenerator(secret));
+      _rngs_with_servers[server_idx] = QSharedPointer<KeystreamGenerator>(
+          _crypto_lib->GetKeystreamGenerator(secret));
     }
 
     // Set up shared secrets
@@ -73,13 +93,14 @@ namespace Tolerant {
       _server_idx = GetGroup().GetSubgroup().GetIndex(GetLocalId());
 
       // Get shared secrets with users
-      const Group users = GetGroup();
+      QVector<QByteArray> user_secrets =
+        SharedSecretCache::GetSharedSecrets(dh_key, user_pks);
       for(int user_idx=0; user_idx<users.Count(); user_idx++) {
-        QByteArray user_pk = users.GetPublicDiffieHellman(user_idx);
-        QByteArray secret = ident.GetDhKey()->GetSharedSecret(user_pk);
+        QByteArray secret = user_secrets[user_idx];
 
         _secrets_with_users[user_idx] = secret;
-        _rngs_with_users[user_idx] = QSharedPointer<Random>(_crypto_lib->GetRandomNumberGenerator(secret));
+        _rngs_with_users[user_idx] = QSharedPointer<KeystreamGenerator>(
+            _crypto_lib->GetKeystreamGenerator(secret));
       }
     }
 
@@ -548,7 +569,7 @@ namespace Tolerant {
   QByteArray TolerantBulkRound::ProcessMessage(const QByteArray &slot_string, uint member_idx)
   {
     QSharedPointer<AsymmetricKey> verification_key(_slot_signing_keys[member_idx]);
-    uint vkey_size = verification_key->GetKeySize() / 8;
+    uint vkey_size = verification_key->GetSignatureLength();
 
     // Remove message randomization
     QByteArray cleartext = _message_randomizer.Derandomize(slot_string);
@@ -1301,13 +1322,14 @@ namespace Tolerant {
 
     const uint total_bytes = prev_bytes + slot_length;
 
-    QByteArray bytes(total_bytes+1, 0);
-
-    QSharedPointer<Random> rand(_crypto_lib->GetRandomNumberGenerator(seed));
+    // Jump straight to the accused byte rather than replaying the pad
+    QSharedPointer<KeystreamGenerator> rand(_crypto_lib->GetKeystreamGenerator(seed));
+    rand->Seek(total_bytes);
 
+    QByteArray bytes(1, 0);
     rand->GenerateBlock(bytes);
 
-    const char expected_byte = bytes[total_bytes];
+    const char expected_byte = bytes[0];
 
     qDebug() << "Getting expected bit from byte" << prev_bytes
       << "+" << slot_length << ", bit" << (int)acc.GetBitIndex() 
@@ -1423,7 +1445,7 @@ namespace Tolerant {
       _header_lengths.append(1  // shuffle byte
           + 4                   // phase
           + 4                   // message length
-          + (_slot_signing_keys.last()->GetKeySize() / 8) // signature
+          + _slot_signing_keys.last()->GetSignatureLength() // signature
           + _message_randomizer.GetHeaderLength() // randomizer seed
         );
 
@@ -20,6 +20,7 @@
 namespace Dissent {
 namespace Crypto {
   class DiffieHellman;
+  class KeystreamGenerator;
   class Library;
 }
 
@@ -49,6 +50,7 @@ namespace Tolerant {
       typedef Dissent::Anonymity::Round Round;
       typedef Dissent::Crypto::DiffieHellman DiffieHellman;
       typedef Dissent::Crypto::Hash Hash;
+      typedef Dissent::Crypto::KeystreamGenerator KeystreamGenerator;
       typedef Dissent::Crypto::Library Library;
       typedef Dissent::Messaging::BufferSink BufferSink;
       typedef Dissent::Messaging::Request Request;
@@ -516,9 +518,9 @@ namespace Tolerant {
        * Protected getters
        */
 
-      inline QVector<QSharedPointer<Random> > &GetRngsWithServers() { return _rngs_with_servers; }
+      inline QVector<QSharedPointer<KeystreamGenerator> > &GetRngsWithServers() { return _rngs_with_servers; }
 
-      inline QVector<QSharedPointer<Random> > &GetRngsWithUsers() { return _rngs_with_users; }
+      inline QVector<QSharedPointer<KeystreamGenerator> > &GetRngsWithUsers() { return _rngs_with_users; }
 
       inline const AlibiData &GetUserAlibiData() const { return _user_alibi_data; }
 
@@ -572,13 +574,13 @@ namespace Tolerant {
        * Secrets and RNGs that a user shares with servers
        */
       QVector<QByteArray> _secrets_with_servers;
-      QVector<QSharedPointer<Random> > _rngs_with_servers;
+      QVector<QSharedPointer<KeystreamGenerator> > _rngs_with_servers;
 
       /**
        * Secrets and RNGs that a server shares with users 
        */
       QVector<QByteArray> _secrets_with_users;
-      QVector<QSharedPointer<Random> > _rngs_with_users;
+      QVector<QSharedPointer<KeystreamGenerator> > _rngs_with_users;
 
       /**
        * Called when it is time to generate the anon key 
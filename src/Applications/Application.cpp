@@ -34,6 +34,9 @@ int main(int argc, char **argv)
     CryptoFactory::GetInstance().SetThreading(CryptoFactory::MultiThreaded);
   }
 
+  CryptoFactory::GetInstance().SetThreadCount(settings.CryptoThreads);
+  CSBulkRound::SetPhasesInFlight(settings.PhasesInFlight);
+
   Library *lib = CryptoFactory::GetInstance().GetLibrary();
 
   Group group(QVector<PublicIdentity>(), Id(settings.LeaderId),
@@ -63,6 +63,16 @@ namespace Applications {
     ExitTunnel = _settings->value(Param<Params::ExitTunnel>()).toBool();
     Multithreading = _settings->value(Param<Params::Multithreading>()).toBool();
 
+    CryptoThreads = 1;
+    if(_settings->contains(Param<Params::CryptoThreads>())) {
+      CryptoThreads = _settings->value(Param<Params::CryptoThreads>()).toInt();
+    }
+
+    PhasesInFlight = 1;
+    if(_settings->contains(Param<Params::PhasesInFlight>())) {
+      PhasesInFlight = _settings->value(Param<Params::PhasesInFlight>()).toInt();
+    }
+
     WebServerUrl = TryParseUrl(_settings->value(Param<Params::WebServerUrl>()).toString(), "http");
     EntryTunnelUrl = TryParseUrl(_settings->value(Param<Params::EntryTunnelUrl>()).toString(), "tcp");
 
@@ -216,6 +226,8 @@ namespace Applications {
     _settings->setValue(Param<Params::DemoMode>(), DemoMode);
     _settings->setValue(Param<Params::Log>(), Log);
     _settings->setValue(Param<Params::Multithreading>(), Multithreading);
+    _settings->setValue(Param<Params::CryptoThreads>(), CryptoThreads);
+    _settings->setValue(Param<Params::PhasesInFlight>(), PhasesInFlight);
     _settings->setValue(Param<Params::LocalId>(), LocalId.ToString());
     _settings->setValue(Param<Params::LeaderId>(), LeaderId.ToString());
     _settings->setValue(Param<Params::SubgroupPolicy>(),
@@ -321,6 +333,14 @@ namespace Applications {
         "enables multithreading",
         QxtCommandOptions::NoValue);
 
+    options->add(Param<Params::CryptoThreads>(),
+        "threads used for parallel crypto work, 0 for one per core",
+        QxtCommandOptions::ValueRequired);
+
+    options->add(Param<Params::PhasesInFlight>(),
+        "csbulk phases in flight at once, 1 waits for each cleartext",
+        QxtCommandOptions::ValueRequired);
+
     options->add(Param<Params::LocalId>(),
         "160-bit base64 local id",
         QxtCommandOptions::ValueRequired);
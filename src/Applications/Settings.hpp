@@ -124,6 +124,16 @@ namespace Applications {
        */
       bool Multithreading;
 
+      /**
+       * Amount of threads used for parallel crypto work, 0 for one per core
+       */
+      int CryptoThreads;
+
+      /**
+       * Amount of CSBulkRound phases that may be in flight at once
+       */
+      int PhasesInFlight;
+
       /**
        * The id for the (first) local node, other nodes will be random
        */
@@ -166,7 +176,9 @@ namespace Applications {
           "local_id",
           "leader_id",
           "subgroup_policy",
-          "super_peer"
+          "super_peer",
+          "crypto_threads",
+          "phases_in_flight"
         };
         return params[id];
       }
@@ -191,7 +203,9 @@ namespace Applications {
             LocalId,
             LeaderId,
             SubgroupPolicy,
-            SuperPeer
+            SuperPeer,
+            CryptoThreads,
+            PhasesInFlight
           };
       };
 
@@ -107,6 +107,12 @@ namespace Crypto {
        */
       virtual int GetKeySize() const = 0;
 
+      /**
+       * Returns the length in bytes of signatures made by this key, which
+       * rounds use to split a signature off of a signed message
+       */
+      virtual int GetSignatureLength() const { return GetKeySize() / 8; }
+
       virtual bool SupportsEncryption() { return true; }
       virtual bool SupportsVerification() { return true; }
 
@@ -0,0 +1,74 @@
+#include "BatchVerifier.hpp"
+#include "CryptoFactory.hpp"
+
+namespace Dissent {
+namespace Crypto {
+namespace {
+  /**
+   * Verifies signatures into a preallocated result array
+   */
+  class VerifyJob : public Utils::TaskScheduler::Job {
+    public:
+      VerifyJob(const QVector<QSharedPointer<AsymmetricKey> > &keys,
+          const QVector<QByteArray> &data, const QVector<QByteArray> &sigs,
+          bool *results) :
+        _keys(keys), _data(data), _sigs(sigs), _results(results)
+      {
+      }
+
+      virtual void Process(int start, int end, int)
+      {
+        for(int idx = start; idx < end; idx++) {
+          _results[idx] = _keys[idx]->Verify(_data[idx], _sigs[idx]);
+        }
+      }
+
+    private:
+      const QVector<QSharedPointer<AsymmetricKey> > &_keys;
+      const QVector<QByteArray> &_data;
+      const QVector<QByteArray> &_sigs;
+      bool *_results;
+  };
+}
+
+  int BatchVerifier::Add(const QSharedPointer<AsymmetricKey> &key,
+      const QByteArray &data, const QByteArray &sig)
+  {
+    _keys.append(key);
+    _data.append(data);
+    _sigs.append(sig);
+    return _keys.count() - 1;
+  }
+
+  QVector<bool> BatchVerifier::Verify(int threads) const
+  {
+    int count = _keys.count();
+    QVector<bool> results(count, false);
+    if(count == 0) {
+      return results;
+    }
+
+    VerifyJob job(_keys, _data, _sigs, results.data());
+    CryptoFactory::GetInstance().GetScheduler().ParallelFor(count, job,
+        Utils::TaskScheduler::Critical, threads);
+    return results;
+  }
+
+  bool BatchVerifier::VerifyAll(int threads) const
+  {
+    foreach(bool result, Verify(threads)) {
+      if(!result) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void BatchVerifier::Clear()
+  {
+    _keys.clear();
+    _data.clear();
+    _sigs.clear();
+  }
+}
+}
@@ -0,0 +1,62 @@
+#ifndef DISSENT_CRYPTO_BATCH_VERIFIER_H_GUARD
+#define DISSENT_CRYPTO_BATCH_VERIFIER_H_GUARD
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "AsymmetricKey.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Collects signature checks and performs them together across the
+   * CryptoFactory thread pool.  Results are returned in the order the
+   * checks were added, so callers can act on them exactly as they would
+   * have serially.
+   */
+  class BatchVerifier {
+    public:
+      /**
+       * Queues a signature check
+       * @param key the verification key
+       * @param data the signed data
+       * @param sig the signature
+       * @returns the index of the result
+       */
+      int Add(const QSharedPointer<AsymmetricKey> &key, const QByteArray &data,
+          const QByteArray &sig);
+
+      /**
+       * Performs all queued checks, returning their results in order
+       * @param threads the amount of threads to use, 0 uses the
+       * CryptoFactory thread count
+       */
+      QVector<bool> Verify(int threads = 0) const;
+
+      /**
+       * Returns true if every queued check passes
+       * @param threads the amount of threads to use, 0 uses the
+       * CryptoFactory thread count
+       */
+      bool VerifyAll(int threads = 0) const;
+
+      /**
+       * Returns the amount of queued checks
+       */
+      inline int Count() const { return _keys.count(); }
+
+      /**
+       * Removes all queued checks
+       */
+      void Clear();
+
+    private:
+      QVector<QSharedPointer<AsymmetricKey> > _keys;
+      QVector<QByteArray> _data;
+      QVector<QByteArray> _sigs;
+  };
+}
+}
+
+#endif
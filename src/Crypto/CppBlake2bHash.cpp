@@ -0,0 +1,30 @@
+#include "CppBlake2bHash.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  void CppBlake2bHash::Restart()
+  {
+    _blake2b.Restart();
+  }
+
+  void CppBlake2bHash::Update(const QByteArray &data)
+  {
+    _blake2b.Update(reinterpret_cast<const byte *>(data.data()), data.size());
+  }
+
+  QByteArray CppBlake2bHash::ComputeHash()
+  {
+    QByteArray hash(GetDigestSize(), 0);
+    _blake2b.Final(reinterpret_cast<byte *>(hash.data()));
+    return hash;
+  }
+
+  QByteArray CppBlake2bHash::ComputeHash(const QByteArray &data)
+  {
+    QByteArray hash(GetDigestSize(), 0);
+    _blake2b.CalculateDigest(reinterpret_cast<byte *>(hash.data()),
+        reinterpret_cast<const byte *>(data.data()), data.size());
+    return hash;
+  }
+}
+}
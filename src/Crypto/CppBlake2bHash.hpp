@@ -0,0 +1,34 @@
+#ifndef DISSENT_CRYPTO_CPP_BLAKE2B_HASH_H_GUARD
+#define DISSENT_CRYPTO_CPP_BLAKE2B_HASH_H_GUARD
+
+#include <QByteArray>
+
+#include <cryptopp/blake2.h>
+
+#include "Hash.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Hash wrapper for CryptoPP::BLAKE2b with its full 64 byte digest, faster
+   * than SHA-256 in software on 64-bit processors
+   */
+  class CppBlake2bHash : public Hash {
+    public:
+      /**
+       * Destructor
+       */
+      virtual ~CppBlake2bHash() {}
+
+      inline virtual int GetDigestSize() { return _blake2b.DigestSize(); }
+      virtual void Restart();
+      virtual void Update(const QByteArray &data);
+      virtual QByteArray ComputeHash();
+      virtual QByteArray ComputeHash(const QByteArray &data);
+    private:
+      CryptoPP::BLAKE2b _blake2b;
+  };
+}
+}
+
+#endif
@@ -25,7 +25,7 @@ namespace Crypto {
     CppDsaPublicKey(new KeyBase::PrivateKey())
   {
     KeyBase::PrivateKey *key = const_cast<KeyBase::PrivateKey*>(GetDsaPrivateKey());
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
     key->Initialize(rng, CppIntegerData::GetInteger(modulus),
         CppIntegerData::GetInteger(subgroup),
         CppIntegerData::GetInteger(generator));
@@ -48,7 +48,7 @@ namespace Crypto {
   CppDsaPrivateKey::CppDsaPrivateKey() :
     CppDsaPublicKey(new KeyBase::PrivateKey())
   {
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
     KeyBase::PrivateKey *key = const_cast<KeyBase::PrivateKey *>(GetDsaPrivateKey());
 
     int keysize = std::max(DefaultKeySize, GetMinimumKeySize());
@@ -84,7 +84,7 @@ namespace Crypto {
 
     KeyBase::Signer signer(*GetDsaPrivateKey());
     QByteArray sig(signer.MaxSignatureLength(), 0);
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
     signer.SignMessage(rng, reinterpret_cast<const byte *>(data.data()),
         data.size(), reinterpret_cast<byte *>(sig.data()));
     return sig;
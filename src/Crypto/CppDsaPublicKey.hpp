@@ -16,6 +16,7 @@
 #include <cryptopp/sha.h>
 
 #include "AsymmetricKey.hpp"
+#include "CppRandom.hpp"
 #include "Integer.hpp"
 
 namespace Dissent {
@@ -151,7 +152,8 @@ namespace Crypto {
       bool InitFromFile(const QString &filename);
 
       /**
-       * Prevents a remote user from giving a malicious DSA key
+       * Prevents a remote user from giving a malicious DSA key and
+       * precomputes the generator's fixed-base table for valid keys
        */
       inline bool Validate()
       {
@@ -161,9 +163,13 @@ namespace Crypto {
           return false;
         }
         
-        CryptoPP::AutoSeededX917RNG<CryptoPP::DES_EDE3> rng;
+        CryptoPP::RandomNumberGenerator &rng =
+          CppRandom::GetPooledGenerator();
         if(GetCryptoMaterial()->Validate(rng, 1)) {
           _key_size = GetGroupParameters().GetModulus().BitCount();
+          // Every signature and verification raises the generator to a
+          // fresh exponent, as CppEcPrivateKey does for its curve
+          const_cast<Key *>(_key)->AccessAbstractGroupParameters().Precompute();
           _valid = true;
           return true;
         }
@@ -0,0 +1,193 @@
+#include <QDataStream>
+
+#include "cryptopp/modarith.h"
+
+#include "CppEcDiffieHellman.hpp"
+#include "CppEcPublicKey.hpp"
+#include "CppHash.hpp"
+#include "CppIntegerData.hpp"
+#include "CppRandom.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  CppEcDiffieHellman::CppEcDiffieHellman(const QByteArray &data, bool seed) :
+    _dh_params(CppEcPublicKey::GetCurve())
+  {
+    _dh_params.AccessGroupParameters().SetPointCompression(true);
+
+    _public_key = QByteArray(_dh_params.PublicKeyLength(), 0);
+    _private_key = QByteArray(_dh_params.PrivateKeyLength(), 0);
+    CppRandom rng(data);
+
+    if(data.isEmpty() || seed) {
+      _dh_params.GenerateKeyPair(*rng.GetHandle(),
+          reinterpret_cast<byte *>(_private_key.data()),
+          reinterpret_cast<byte *>(_public_key.data()));
+    } else {
+      // Normalize the private component to the expected length
+      CryptoPP::Integer exponent(reinterpret_cast<const byte *>(data.data()),
+          data.size());
+      exponent.Encode(reinterpret_cast<byte *>(_private_key.data()),
+          _private_key.size());
+      // This DOES NOT use the rng
+      _dh_params.GeneratePublicKey(*rng.GetHandle(),
+          reinterpret_cast<byte *>(_private_key.data()),
+          reinterpret_cast<byte *>(_public_key.data()));
+    }
+  }
+
+  QByteArray CppEcDiffieHellman::GetSharedSecret(const QByteArray &remote_pub) const
+  {
+    if(remote_pub.size() != int(_dh_params.PublicKeyLength())) {
+      return QByteArray();
+    }
+
+    QByteArray shared = QByteArray(_dh_params.AgreedValueLength(), 0);
+
+    bool valid = _dh_params.Agree(reinterpret_cast<byte *>(shared.data()),
+        reinterpret_cast<const byte *>(_private_key.data()),
+        reinterpret_cast<const byte *>(remote_pub.data()));
+
+    if(!valid) {
+      shared.clear();
+    }
+
+    return shared;
+  }
+
+  QByteArray CppEcDiffieHellman::ProveSharedSecret(const QByteArray &remote_pub) const
+  {
+    const Parameters &params = _dh_params.GetGroupParameters();
+    CryptoPP::ModularArithmetic mod_order(params.GetSubgroupOrder());
+
+    // B = g^b  -- where b is the other guy's secret
+    Point other;
+    if(!DecodePoint(remote_pub, other)) {
+      qWarning() << "In CppEcDiffieHellman::ProveSharedSecret: invalid remote";
+      return QByteArray();
+    }
+
+    // a = prover secret
+    CryptoPP::Integer prover_priv(
+        reinterpret_cast<const byte *>(_private_key.data()), _private_key.size());
+
+    // A random value v in the group Z_q
+    CppEcDiffieHellman rand_key;
+    CryptoPP::Integer value(
+        reinterpret_cast<const byte *>(rand_key._private_key.data()),
+        rand_key._private_key.size());
+
+    // B^a
+    QByteArray dh_secret = EncodePoint(params.ExponentiateElement(other, prover_priv));
+
+    QList<QByteArray> list;
+    // g, g^a, g^b, g^ab, t_1 = g^v, t_2 = B^v
+    list << EncodePoint(params.GetSubgroupGenerator()) << _public_key <<
+      remote_pub << dh_secret << rand_key.GetPublicComponent() <<
+      EncodePoint(params.ExponentiateElement(other, value));
+
+    // c = HASH(g, g^a, g^b, g^ab, t_1, t_2)
+    CryptoPP::Integer challenge = HashPoints(list);
+
+    // r = v - ca mod q
+    CryptoPP::Integer response = mod_order.Subtract(value,
+        mod_order.Multiply(challenge, prover_priv));
+
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream << dh_secret << CppIntegerData(challenge).GetByteArray() <<
+      CppIntegerData(response).GetByteArray();
+    return out;
+  }
+
+  QByteArray CppEcDiffieHellman::VerifySharedSecret(const QByteArray &prover_pub,
+      const QByteArray &remote_pub, const QByteArray &proof) const
+  {
+    const Parameters &params = _dh_params.GetGroupParameters();
+
+    QDataStream stream(proof);
+    QByteArray bytes_dh_secret, bytes_challenge, bytes_response;
+    stream >> bytes_dh_secret >> bytes_challenge >> bytes_response;
+
+    Point prover, other, dh_secret;
+    if(!DecodePoint(prover_pub, prover) || !DecodePoint(remote_pub, other) ||
+        !DecodePoint(bytes_dh_secret, dh_secret))
+    {
+      return QByteArray();
+    }
+
+    CryptoPP::Integer challenge = CppIntegerData(bytes_challenge).GetCryptoInteger();
+    CryptoPP::Integer response = CppIntegerData(bytes_response).GetCryptoInteger();
+    if(challenge >= params.GetSubgroupOrder() ||
+        response >= params.GetSubgroupOrder())
+    {
+      return QByteArray();
+    }
+
+    const CryptoPP::ECP &curve = params.GetCurve();
+
+    // commit'_1 = g^r * (g^a)^c
+    Point commit_1 = curve.CascadeScalarMultiply(params.GetSubgroupGenerator(),
+        response, prover, challenge);
+
+    // commit'_2 = (g^b)^r * (g^ab)^c
+    Point commit_2 = curve.CascadeScalarMultiply(other, response,
+        dh_secret, challenge);
+
+    QList<QByteArray> list;
+    list << EncodePoint(params.GetSubgroupGenerator()) << prover_pub <<
+      remote_pub << bytes_dh_secret << EncodePoint(commit_1) <<
+      EncodePoint(commit_2);
+
+    if(HashPoints(list) != challenge) {
+      return QByteArray();
+    }
+
+    return EncodeSecret(dh_secret);
+  }
+
+  bool CppEcDiffieHellman::DecodePoint(const QByteArray &data, Point &point) const
+  {
+    const Parameters &params = _dh_params.GetGroupParameters();
+    if(data.size() != int(params.GetEncodedElementSize(true))) {
+      return false;
+    }
+
+    try {
+      point = params.DecodeElement(
+          reinterpret_cast<const byte *>(data.data()), true);
+    } catch (std::exception &) {
+      return false;
+    }
+    return true;
+  }
+
+  QByteArray CppEcDiffieHellman::EncodePoint(const Point &point) const
+  {
+    const Parameters &params = _dh_params.GetGroupParameters();
+    QByteArray data(params.GetEncodedElementSize(true), 0);
+    params.EncodeElement(true, point, reinterpret_cast<byte *>(data.data()));
+    return data;
+  }
+
+  QByteArray CppEcDiffieHellman::EncodeSecret(const Point &point) const
+  {
+    const Parameters &params = _dh_params.GetGroupParameters();
+    QByteArray data(params.GetEncodedElementSize(false), 0);
+    params.EncodeElement(false, point, reinterpret_cast<byte *>(data.data()));
+    return data;
+  }
+
+  CryptoPP::Integer CppEcDiffieHellman::HashPoints(const QList<QByteArray> &list) const
+  {
+    CppHash hash;
+    foreach(const QByteArray &point, list) {
+      hash.Update(point);
+    }
+
+    QByteArray digest = hash.ComputeHash();
+    return CryptoPP::Integer(reinterpret_cast<const byte *>(digest.data()),
+        digest.size()) % _dh_params.GetGroupParameters().GetSubgroupOrder();
+  }
+}
+}
@@ -0,0 +1,103 @@
+#ifndef DISSENT_CRYPTO_CPP_EC_DIFFIE_HELLMAN_KEY_H_GUARD
+#define DISSENT_CRYPTO_CPP_EC_DIFFIE_HELLMAN_KEY_H_GUARD
+
+#include <QList>
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+
+#include "DiffieHellman.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Elliptic curve DiffieHellman, using the same curve as CppEcPublicKey.
+   * Public components are compressed points, shared secrets are the
+   * x-coordinate of the agreed point.
+   */
+  class CppEcDiffieHellman : public DiffieHellman {
+    public:
+      typedef CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> Parameters;
+      typedef CryptoPP::ECPPoint Point;
+
+      /**
+       * Constructor
+       * @param data empty, private key, or seed if seed is true
+       * @param seed specifies is data is a private key or a seed
+       */
+      explicit CppEcDiffieHellman(const QByteArray &data = QByteArray(),
+          bool seed = false);
+
+      /**
+       * Destructor
+       */
+      virtual ~CppEcDiffieHellman() {}
+
+      /**
+       * Retrieves the public component of the Diffie-Hellman agreement
+       */
+      virtual QByteArray GetPublicComponent() const { return _public_key; }
+
+      /**
+       * Retrieves the private component of the Diffie-Hellman agreement
+       */
+      virtual QByteArray GetPrivateComponent() const { return _private_key; }
+
+      /**
+       * Return the shared secret given the other sides public component
+       * @param remote_pub the other sides public component
+       */
+      virtual QByteArray GetSharedSecret(const QByteArray &remote_pub) const;
+
+      /**
+       * Return a non-interactive zero-knowledge proof of a shared
+       * Diffie-Hellman secret, the proof is the curve analog of the one in
+       * CppDiffieHellman
+       * @param remote_pub the other sides public component
+       */
+      virtual QByteArray ProveSharedSecret(const QByteArray &remote_pub) const;
+
+      /**
+       * Verify a non-interactive zero-knowledge proof of a shared
+       * Diffie-Hellman secret.
+       * @returns QByteArray() if verification fails, otherwise returns the
+       * shared secret
+       */
+      virtual QByteArray VerifySharedSecret(const QByteArray &prover_pub,
+          const QByteArray &remote_pub, const QByteArray &proof) const;
+
+    private:
+      /**
+       * Decodes and validates a point, returns false if the point is not a
+       * valid element of the group
+       * @param data the encoded point
+       * @param point the decoded point
+       */
+      bool DecodePoint(const QByteArray &data, Point &point) const;
+
+      /**
+       * Returns the compressed encoding of a point
+       * @param point the point to encode
+       */
+      QByteArray EncodePoint(const Point &point) const;
+
+      /**
+       * Returns the shared secret encoding of a point, its x-coordinate
+       * @param point the agreed point
+       */
+      QByteArray EncodeSecret(const Point &point) const;
+
+      /**
+       * Hash the list of encoded points into an exponent
+       * @param list the encoded points
+       */
+      CryptoPP::Integer HashPoints(const QList<QByteArray> &list) const;
+
+      CryptoPP::ECDH<CryptoPP::ECP>::Domain _dh_params;
+      QByteArray _public_key;
+      QByteArray _private_key;
+  };
+}
+}
+
+#endif
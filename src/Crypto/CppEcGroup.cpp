@@ -0,0 +1,120 @@
+#include "CppEcGroup.hpp"
+#include "CppEcPublicKey.hpp"
+#include "CppIntegerData.hpp"
+#include "CppRandom.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  namespace {
+    CppEcGroup::Parameters *BuildParameters()
+    {
+      CppEcGroup::Parameters *params =
+        new CppEcGroup::Parameters(CppEcPublicKey::GetCurve());
+      params->SetPointCompression(true);
+      params->Precompute();
+      return params;
+    }
+  }
+
+  const CppEcGroup::Parameters &CppEcGroup::GetParameters()
+  {
+    static const Parameters *params = BuildParameters();
+    return *params;
+  }
+
+  bool CppEcGroup::IsGroup(const Parameters &params)
+  {
+    const Parameters &group = GetParameters();
+    return params.GetCurve() == group.GetCurve() &&
+      params.GetSubgroupOrder() == group.GetSubgroupOrder() &&
+      params.GetCofactor() == group.GetCofactor();
+  }
+
+  bool CppEcGroup::InitializeParameters(const Integer &generator,
+      Parameters &params)
+  {
+    Point base;
+    if(!DecodePoint(generator, base)) {
+      return false;
+    }
+
+    const Parameters &group = GetParameters();
+    params.Initialize(group.GetCurve(), base, group.GetSubgroupOrder(),
+        group.GetCofactor());
+    params.SetPointCompression(true);
+    return true;
+  }
+
+  Integer CppEcGroup::GetGenerator()
+  {
+    return EncodePoint(GetParameters().GetSubgroupGenerator());
+  }
+
+  Integer CppEcGroup::GetOrder()
+  {
+    return Integer(new CppIntegerData(GetParameters().GetSubgroupOrder()));
+  }
+
+  Integer CppEcGroup::GetRandomExponent()
+  {
+    CryptoPP::RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    CryptoPP::Integer exponent(rng, CryptoPP::Integer::One(),
+        GetParameters().GetMaxExponent());
+    return Integer(new CppIntegerData(exponent));
+  }
+
+  bool CppEcGroup::IsElement(const Integer &element)
+  {
+    Point point;
+    return DecodePoint(element, point);
+  }
+
+  Integer CppEcGroup::Multiply(const Integer &element, const Integer &scalar)
+  {
+    Point point;
+    if(!DecodePoint(element, point)) {
+      return Integer(0);
+    }
+
+    const Parameters &params = GetParameters();
+    CryptoPP::Integer exponent = CppIntegerData::GetInteger(scalar) %
+      params.GetSubgroupOrder();
+
+    if(point == params.GetSubgroupGenerator()) {
+      return EncodePoint(params.ExponentiateBase(exponent));
+    }
+    return EncodePoint(params.ExponentiateElement(point, exponent));
+  }
+
+  bool CppEcGroup::DecodePoint(const Integer &element, Point &point)
+  {
+    const Parameters &params = GetParameters();
+    CryptoPP::Integer value = CppIntegerData::GetInteger(element);
+
+    unsigned int size = params.GetEncodedElementSize(true);
+    if(value.IsNegative() || value.MinEncodedSize() != size) {
+      return false;
+    }
+
+    QByteArray data(size, 0);
+    value.Encode(reinterpret_cast<byte *>(data.data()), size);
+
+    try {
+      point = params.DecodeElement(
+          reinterpret_cast<const byte *>(data.data()), true);
+    } catch (std::exception &) {
+      return false;
+    }
+
+    return !params.IsIdentity(point);
+  }
+
+  Integer CppEcGroup::EncodePoint(const Point &point)
+  {
+    const Parameters &params = GetParameters();
+    QByteArray data(params.GetEncodedElementSize(true), 0);
+    params.EncodeElement(true, point, reinterpret_cast<byte *>(data.data()));
+    return Integer(new CppIntegerData(data));
+  }
+}
+}
@@ -0,0 +1,94 @@
+#ifndef DISSENT_CRYPTO_CPP_EC_GROUP_H_GUARD
+#define DISSENT_CRYPTO_CPP_EC_GROUP_H_GUARD
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+
+#include "Integer.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Group operations on the curve used by CppEcPublicKey, for protocols that
+   * handle group elements directly such as the Neff key shuffle.  Elements
+   * are passed around as Integers holding the compressed point encoding,
+   * whose leading 0x02 / 0x03 byte makes the Integer round trip exact.
+   */
+  class CppEcGroup {
+    public:
+      typedef CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> Parameters;
+      typedef CryptoPP::ECPPoint Point;
+
+      /**
+       * Returns the shared group parameters, with point compression enabled
+       */
+      static const Parameters &GetParameters();
+
+      /**
+       * Returns true if the parameters describe the same curve and subgroup
+       * as GetParameters, the base point may differ
+       * @param params the parameters to check
+       */
+      static bool IsGroup(const Parameters &params);
+
+      /**
+       * Initializes params to the shared group with a different base point,
+       * returns false if generator is not a valid element
+       * @param generator the encoded base point
+       * @param params the parameters to initialize
+       */
+      static bool InitializeParameters(const Integer &generator,
+          Parameters &params);
+
+      /**
+       * Returns the encoded standard base point
+       */
+      static Integer GetGenerator();
+
+      /**
+       * Returns the order of the subgroup
+       */
+      static Integer GetOrder();
+
+      /**
+       * Returns a random exponent in [1, order)
+       */
+      static Integer GetRandomExponent();
+
+      /**
+       * Returns true if element encodes a point of the group other than the
+       * identity
+       * @param element the encoded point
+       */
+      static bool IsElement(const Integer &element);
+
+      /**
+       * Returns element * scalar or 0 if element is not a valid element
+       * @param element the encoded point
+       * @param scalar the exponent
+       */
+      static Integer Multiply(const Integer &element, const Integer &scalar);
+
+      /**
+       * Decodes and validates an encoded point
+       * @param element the encoded point
+       * @param point the decoded point
+       */
+      static bool DecodePoint(const Integer &element, Point &point);
+
+      /**
+       * Returns the encoding of a point
+       * @param point the point to encode
+       */
+      static Integer EncodePoint(const Point &point);
+
+    private:
+      /**
+       * No instances of this class
+       */
+      CppEcGroup() {}
+  };
+}
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef DISSENT_CRYPTO_CPP_EC_LIBRARY_H_GUARD
+#define DISSENT_CRYPTO_CPP_EC_LIBRARY_H_GUARD
+
+#include "CppEcDiffieHellman.hpp"
+#include "CppEcPrivateKey.hpp"
+#include "CppEcPublicKey.hpp"
+#include "CppHash.hpp"
+#include "CppIntegerData.hpp"
+#include "CppKeystreamGenerator.hpp"
+#include "CppRandom.hpp"
+
+#include "Library.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * CryptoPP based library using elliptic curves: ECDSA / ECIES keys and
+   * ECDH over NIST P-256, everything else matches CppLibrary
+   */
+  class CppEcLibrary : public Library {
+    public:
+      using Library::GetKeystreamGenerator;
+
+      /**
+       * Load a public key from a file
+       */
+      inline virtual AsymmetricKey *LoadPublicKeyFromFile(const QString &filename)
+      {
+        return new CppEcPublicKey(filename);
+      }
+
+      /**
+       * Loading a public key from a byte array
+       */
+      inline virtual AsymmetricKey *LoadPublicKeyFromByteArray(const QByteArray &data) 
+      {
+        return new CppEcPublicKey(data);
+      }
+
+      /**
+       * Generate a public key using the given data as a seed to a RNG
+       */
+      inline virtual AsymmetricKey *GeneratePublicKey(const QByteArray &seed) 
+      {
+        return CppEcPublicKey::GenerateKey(seed);
+      }
+
+      /**
+       * Load a private key from a file
+       */
+      inline virtual AsymmetricKey *LoadPrivateKeyFromFile(const QString &filename) 
+      {
+        return new CppEcPrivateKey(filename);
+      }
+
+      /**
+       * Loading a private key from a byte array
+       */
+      inline virtual AsymmetricKey *LoadPrivateKeyFromByteArray(const QByteArray &data) 
+      {
+        return new CppEcPrivateKey(data);
+      }
+
+      /**
+       * Generate a private key using the given data as a seed to a RNG
+       */
+      inline virtual AsymmetricKey *GeneratePrivateKey(const QByteArray &seed) 
+      {
+        return CppEcPrivateKey::GenerateKey(seed);
+      }
+
+      /**
+       * Generates a unique (new) private key
+       */
+      inline virtual AsymmetricKey *CreatePrivateKey() 
+      {
+        return new CppEcPrivateKey();
+      }
+
+      /**
+       * Returns the minimum asymmetric key size
+       */
+      inline virtual int MinimumKeySize() const { return CppEcPublicKey::GetMinimumKeySize(); }
+
+      /**
+       * Returns a deterministic random number generator
+       */
+      inline virtual Dissent::Utils::Random *GetRandomNumberGenerator(const QByteArray &seed, uint index)
+      {
+        return new CppRandom(seed, index);
+      }
+
+      inline virtual uint RngOptimalSeedSize()
+      {
+        return CppRandom::OptimalSeedSize();
+      }
+
+      /**
+       * Returns an AES counter mode keystream generator
+       * @param seed the key for the keystream
+       * @param nonce distinguishes keystreams sharing the same seed
+       */
+      inline virtual KeystreamGenerator *GetKeystreamGenerator(
+          const QByteArray &seed, const QByteArray &nonce)
+      {
+        return new CppKeystreamGenerator(seed, nonce);
+      }
+
+      /**
+       * Returns a hash algorithm
+       */
+      inline virtual Hash *GetHashAlgorithm() 
+      {
+        return CppHash::Create(CryptoFactory::GetInstance().GetHashName());
+      }
+
+      /**
+       * Returns an integer data
+       */
+      inline virtual IntegerData *GetIntegerData(int value)
+      {
+        return new CppIntegerData(value);
+      }
+
+      /**
+       * Returns an integer data
+       */
+      inline virtual IntegerData *GetIntegerData(const QByteArray &value)
+      {
+        return new CppIntegerData(value);
+      }
+
+      /**
+       * Returns an integer data
+       */
+      inline virtual IntegerData *GetIntegerData(const QString &value)
+      {
+        return new CppIntegerData(value);
+      }
+
+      /**
+       * returns a random integer data
+       * @param bit_count the amount of bits in the integer
+       * @param mod the modulus of the integer
+       * @param prime if the integer should be prime 
+       */
+      virtual IntegerData *GetRandomInteger(int bit_count,
+          const IntegerData *mod, bool prime)
+      {
+        return CppIntegerData::GetRandomInteger(bit_count, mod, prime);
+      }
+
+      /**
+       * Returns a DiffieHellman operator
+       */
+      virtual DiffieHellman *CreateDiffieHellman()
+      {
+        return new CppEcDiffieHellman();
+      }
+
+      /**
+       * Generate a DiffieHellman operator using the given data as a seed to a RNG
+       * @param seed seed used to generate the DiffieHellman exchange
+       */
+      virtual DiffieHellman *GenerateDiffieHellman(const QByteArray &seed)
+      {
+        return new CppEcDiffieHellman(seed, true);
+      }
+
+      /**
+       * Loads a DiffieHellman key from a byte array
+       * @param private_component the private component in the DH exchange
+       */
+      virtual DiffieHellman *LoadDiffieHellman(const QByteArray &private_component)
+      {
+        return new CppEcDiffieHellman(private_component);
+      }
+  };
+}
+}
+
+#endif
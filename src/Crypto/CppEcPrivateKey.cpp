@@ -0,0 +1,183 @@
+#include "CppEcGroup.hpp"
+#include "CppEcPrivateKey.hpp"
+#include "CppIntegerData.hpp"
+#include "CppPublicKey.hpp"
+#include "CppRandom.hpp"
+
+using namespace CryptoPP;
+
+namespace Dissent {
+namespace Crypto {
+  CppEcPrivateKey::CppEcPrivateKey() :
+    _private_key(new KeyBase::PrivateKey())
+  {
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    _private_key->Initialize(rng, GetCurve());
+    ValidatePrivate();
+  }
+
+  CppEcPrivateKey::CppEcPrivateKey(const QString &filename) :
+    _private_key(new KeyBase::PrivateKey())
+  {
+    QByteArray data;
+    if(ReadFile(filename, data) && InitFromByteArray(data)) {
+      ValidatePrivate();
+    }
+  }
+
+  CppEcPrivateKey::CppEcPrivateKey(const QByteArray &data) :
+    _private_key(new KeyBase::PrivateKey())
+  {
+    if(InitFromByteArray(data)) {
+      ValidatePrivate();
+    }
+  }
+
+  CppEcPrivateKey::CppEcPrivateKey(const Integer &generator) :
+    _private_key(new KeyBase::PrivateKey())
+  {
+    Parameters params;
+    if(!CppEcGroup::InitializeParameters(generator, params)) {
+      qWarning() << "In CppEcPrivateKey::CppEcPrivateKey: invalid generator";
+      return;
+    }
+
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    _private_key->Initialize(rng, params);
+    ValidatePrivate();
+  }
+
+  CppEcPrivateKey::CppEcPrivateKey(const Integer &generator,
+      const Integer &private_exp) :
+    _private_key(new KeyBase::PrivateKey())
+  {
+    Parameters params;
+    if(!CppEcGroup::InitializeParameters(generator, params)) {
+      qWarning() << "In CppEcPrivateKey::CppEcPrivateKey: invalid generator";
+      return;
+    }
+
+    _private_key->Initialize(params, CppIntegerData::GetInteger(private_exp));
+    ValidatePrivate();
+  }
+
+  CppEcPrivateKey::CppEcPrivateKey(KeyBase::PrivateKey *key) :
+    _private_key(key)
+  {
+    ValidatePrivate();
+  }
+
+  CppEcPrivateKey *CppEcPrivateKey::GenerateKey(const QByteArray &data)
+  {
+    CppRandom rng(data);
+    KeyBase::PrivateKey *key = new KeyBase::PrivateKey();
+    key->Initialize(*rng.GetHandle(), GetCurve());
+    return new CppEcPrivateKey(key);
+  }
+
+  bool CppEcPrivateKey::InitFromByteArray(const QByteArray &data)
+  {
+    ByteQueue queue;
+    queue.Put2(reinterpret_cast<const byte *>(data.data()), data.size(), 0, true);
+
+    try {
+      _private_key->Load(queue);
+    } catch (std::exception &e) {
+      qWarning() << "In CppEcPrivateKey::InitFromByteArray: " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+  void CppEcPrivateKey::ValidatePrivate()
+  {
+    _valid = false;
+    _key_size = 0;
+
+    if(!CppEcGroup::IsGroup(_private_key->GetGroupParameters())) {
+      qWarning() << "In CppEcPrivateKey::ValidatePrivate: key is not on" <<
+        "the expected curve";
+      return;
+    }
+
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    if(!_private_key->Validate(rng, 1)) {
+      return;
+    }
+
+    _private_key->AccessGroupParameters().SetPointCompression(true);
+    _private_key->MakePublicKey(*_public_key);
+    Validate();
+    if(!_valid) {
+      return;
+    }
+
+    Signer *signer = new Signer(*_private_key);
+    signer->AccessKey().AccessGroupParameters().Precompute();
+    _signer.reset(signer);
+    _decryptor.reset(new Decryptor(*_private_key));
+  }
+
+  Integer CppEcPrivateKey::GetPrivateExponent() const
+  {
+    return Integer(new CppIntegerData(_private_key->GetPrivateExponent()));
+  }
+
+  QByteArray CppEcPrivateKey::GetByteArray() const
+  {
+    if(!_valid) {
+      return QByteArray();
+    }
+
+    return CppPublicKey::GetByteArray(*_private_key);
+  }
+
+  QByteArray CppEcPrivateKey::Sign(const QByteArray &data) const
+  {
+    if(!_valid) {
+      qCritical() << "Trying to sign with an invalid key";
+      return QByteArray();
+    }
+
+    QByteArray sig(_signer->MaxSignatureLength(), 0);
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    size_t length = _signer->SignMessage(rng,
+        reinterpret_cast<const byte *>(data.data()), data.size(),
+        reinterpret_cast<byte *>(sig.data()));
+    sig.resize(length);
+    return sig;
+  }
+
+  QByteArray CppEcPrivateKey::Decrypt(const QByteArray &data) const
+  {
+    if(!_valid) {
+      qCritical() << "Trying to decrypt with an invalid key";
+      return QByteArray();
+    }
+
+    if(data.size() < int(_decryptor->CiphertextLength(0))) {
+      qWarning() << "In CppEcPrivateKey::Decrypt: ciphertext too small";
+      return QByteArray();
+    }
+
+    QByteArray cleartext(_decryptor->MaxPlaintextLength(data.size()), 0);
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+
+    try {
+      DecodingResult result = _decryptor->Decrypt(rng,
+          reinterpret_cast<const byte *>(data.data()), data.size(),
+          reinterpret_cast<byte *>(cleartext.data()));
+      if(!result.isValidCoding) {
+        qWarning() << "In CppEcPrivateKey::Decrypt: invalid ciphertext";
+        return QByteArray();
+      }
+      cleartext.resize(result.messageLength);
+    } catch (std::exception &e) {
+      qWarning() << "In CppEcPrivateKey::Decrypt: " << e.what();
+      return QByteArray();
+    }
+
+    return cleartext;
+  }
+}
+}
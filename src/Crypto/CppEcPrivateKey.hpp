@@ -0,0 +1,99 @@
+#ifndef DISSENT_CRYPTO_CPP_EC_PRIVATE_KEY_H_GUARD
+#define DISSENT_CRYPTO_CPP_EC_PRIVATE_KEY_H_GUARD
+
+#include <QByteArray>
+#include <QDebug>
+#include <QString>
+
+#include "CppEcPublicKey.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Implementation of an elliptic curve private key using CryptoPP
+   */
+  class CppEcPrivateKey : public CppEcPublicKey {
+    public:
+      /**
+       * Creates a new random key
+       */
+      explicit CppEcPrivateKey();
+
+      /**
+       * Reads a key from a file
+       * @param filename the file storing the key
+       */
+      explicit CppEcPrivateKey(const QString &filename);
+
+      /**
+       * Loads a key from memory
+       * @param data byte array holding the key
+       */
+      explicit CppEcPrivateKey(const QByteArray &data);
+
+      /**
+       * Creates a new random key with a different base point
+       * @param generator the encoded base point g
+       */
+      explicit CppEcPrivateKey(const Integer &generator);
+
+      /**
+       * Creates a key with a different base point given its exponent
+       * @param generator the encoded base point g
+       * @param private_exp the x of the private key
+       */
+      explicit CppEcPrivateKey(const Integer &generator,
+          const Integer &private_exp);
+
+      /**
+       * Destructor
+       */
+      virtual ~CppEcPrivateKey() {}
+
+      /**
+       * Creates a private key based upon the seed data, same seed data same
+       * key.  This is mainly used for distributed tests, so other members can
+       * generate an appropriate public key.
+       */
+      static CppEcPrivateKey *GenerateKey(const QByteArray &data);
+
+      virtual QByteArray GetByteArray() const;
+      virtual QByteArray Sign(const QByteArray &data) const;
+      virtual QByteArray Decrypt(const QByteArray &data) const;
+      inline virtual bool IsPrivateKey() const { return true; }
+
+      /**
+       * Returns the x of the private key
+       */
+      Integer GetPrivateExponent() const;
+
+    protected:
+      typedef KeyBase::Signer Signer;
+      typedef EncryptionBase::Decryptor Decryptor;
+
+      /**
+       * Takes ownership of a generated private key
+       * @param key the private key
+       */
+      explicit CppEcPrivateKey(KeyBase::PrivateKey *key);
+
+      /**
+       * Loads a key from the provided byte array
+       * @param data key byte array
+       */
+      bool InitFromByteArray(const QByteArray &data);
+
+      /**
+       * Derives the public key from the private key, validates both and
+       * builds the signer and decryptor, see CppEcPublicKey::Validate
+       */
+      void ValidatePrivate();
+
+      QScopedPointer<KeyBase::PrivateKey> _private_key;
+      QScopedPointer<const Signer> _signer;
+      QScopedPointer<const Decryptor> _decryptor;
+  };
+}
+}
+
+#endif
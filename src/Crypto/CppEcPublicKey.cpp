@@ -0,0 +1,190 @@
+#include "CppEcGroup.hpp"
+#include "CppEcPublicKey.hpp"
+#include "CppEcPrivateKey.hpp"
+#include "CppPublicKey.hpp"
+#include "CppRandom.hpp"
+
+using namespace CryptoPP;
+
+namespace Dissent {
+namespace Crypto {
+  CppEcPublicKey::CppEcPublicKey(const QString &filename) :
+    _public_key(new KeyBase::PublicKey()),
+    _valid(false),
+    _key_size(0)
+  {
+    if(InitFromFile(filename)) {
+      Validate();
+    }
+  }
+
+  CppEcPublicKey::CppEcPublicKey(const QByteArray &data) :
+    _public_key(new KeyBase::PublicKey()),
+    _valid(false),
+    _key_size(0)
+  {
+    if(InitFromByteArray(data)) {
+      Validate();
+    }
+  }
+
+  CppEcPublicKey::CppEcPublicKey(const Integer &generator,
+      const Integer &public_element) :
+    _public_key(new KeyBase::PublicKey()),
+    _valid(false),
+    _key_size(0)
+  {
+    Parameters params;
+    CppEcGroup::Point element;
+    if(!CppEcGroup::InitializeParameters(generator, params) ||
+        !CppEcGroup::DecodePoint(public_element, element))
+    {
+      qWarning() << "In CppEcPublicKey::CppEcPublicKey: invalid elements";
+      return;
+    }
+
+    _public_key->Initialize(params, element);
+    Validate();
+  }
+
+  CppEcPublicKey::~CppEcPublicKey()
+  {
+  }
+
+  CppEcPublicKey *CppEcPublicKey::GenerateKey(const QByteArray &data)
+  {
+    QScopedPointer<CppEcPrivateKey> key(CppEcPrivateKey::GenerateKey(data));
+    return static_cast<CppEcPublicKey *>(key->GetPublicKey());
+  }
+
+  AsymmetricKey *CppEcPublicKey::GetPublicKey() const
+  {
+    if(!_valid) {
+      return 0;
+    }
+
+    return new CppEcPublicKey(CppPublicKey::GetByteArray(*_public_key));
+  }
+
+  bool CppEcPublicKey::InitFromByteArray(const QByteArray &data)
+  {
+    ByteQueue queue;
+    queue.Put2(reinterpret_cast<const byte *>(data.data()), data.size(), 0, true);
+
+    try {
+      _public_key->Load(queue);
+    } catch (std::exception &e) {
+      qWarning() << "In CppEcPublicKey::InitFromByteArray: " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+  bool CppEcPublicKey::InitFromFile(const QString &filename)
+  {
+    QByteArray key;
+    if(ReadFile(filename, key)) {
+      return InitFromByteArray(key);
+    }
+
+    return false;
+  }
+
+  void CppEcPublicKey::Validate()
+  {
+    _valid = false;
+    _key_size = 0;
+
+    if(!CppEcGroup::IsGroup(_public_key->GetGroupParameters())) {
+      qWarning() << "In CppEcPublicKey::Validate: key is not on" <<
+        "the expected curve";
+      return;
+    }
+
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    if(!_public_key->Validate(rng, 1)) {
+      return;
+    }
+
+    _public_key->AccessGroupParameters().SetPointCompression(true);
+
+    Verifier *verifier = new Verifier(*_public_key);
+    verifier->AccessKey().AccessGroupParameters().Precompute();
+    _verifier.reset(verifier);
+    _encryptor.reset(new Encryptor(*_public_key));
+
+    _key_size = _public_key->GetGroupParameters().GetSubgroupOrder().BitCount();
+    _valid = true;
+  }
+
+  QByteArray CppEcPublicKey::GetByteArray() const
+  {
+    if(!_valid) {
+      return QByteArray();
+    }
+
+    return CppPublicKey::GetByteArray(*_public_key);
+  }
+
+  Integer CppEcPublicKey::GetGenerator() const
+  {
+    return CppEcGroup::EncodePoint(
+        _public_key->GetGroupParameters().GetSubgroupGenerator());
+  }
+
+  Integer CppEcPublicKey::GetPublicElement() const
+  {
+    return CppEcGroup::EncodePoint(_public_key->GetPublicElement());
+  }
+
+  QByteArray CppEcPublicKey::Sign(const QByteArray &) const
+  {
+    qWarning() << "In CppEcPublicKey::Sign: Attempting to sign with a public key";
+    return QByteArray();
+  }
+
+  bool CppEcPublicKey::Verify(const QByteArray &data, const QByteArray &sig) const
+  {
+    if(!_valid || sig.size() != int(_verifier->SignatureLength())) {
+      return false;
+    }
+
+    return _verifier->VerifyMessage(reinterpret_cast<const byte *>(data.data()),
+        data.size(), reinterpret_cast<const byte *>(sig.data()), sig.size());
+  }
+
+  QByteArray CppEcPublicKey::Encrypt(const QByteArray &data) const
+  {
+    if(!_valid) {
+      return QByteArray();
+    }
+
+    QByteArray ciphertext(_encryptor->CiphertextLength(data.size()), 0);
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    _encryptor->Encrypt(rng, reinterpret_cast<const byte *>(data.data()),
+        data.size(), reinterpret_cast<byte *>(ciphertext.data()));
+    return ciphertext;
+  }
+
+  QByteArray CppEcPublicKey::Decrypt(const QByteArray &) const
+  {
+    qWarning() << "In CppEcPublicKey::Decrypt: Attempting to decrypt with a public key";
+    return QByteArray();
+  }
+
+  bool CppEcPublicKey::VerifyKey(AsymmetricKey &key) const
+  {
+    if(!IsValid() || !key.IsValid() || (IsPrivateKey() == key.IsPrivateKey())) {
+      return false;
+    }
+
+    CppEcPublicKey *other = dynamic_cast<CppEcPublicKey *>(&key);
+    if(!other) {
+      return false;
+    }
+
+    return other->_public_key->GetPublicElement() ==
+      _public_key->GetPublicElement();
+  }
+}
+}
@@ -0,0 +1,162 @@
+#ifndef DISSENT_CRYPTO_CPP_EC_PUBLIC_KEY_H_GUARD
+#define DISSENT_CRYPTO_CPP_EC_PUBLIC_KEY_H_GUARD
+
+#include <stdexcept>
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QScopedPointer>
+#include <QString>
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+#include <cryptopp/oids.h>
+#include <cryptopp/osrng.h>
+#include <cryptopp/sha.h>
+
+#include "AsymmetricKey.hpp"
+#include "Integer.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Implementation of an elliptic curve public key using CryptoPP, signatures
+   * are ECDSA with SHA-256 and encryption is ECIES over the same curve
+   */
+  class CppEcPublicKey : public AsymmetricKey {
+    public:
+      typedef CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256> KeyBase;
+      typedef CryptoPP::ECIES<CryptoPP::ECP> EncryptionBase;
+      typedef CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> Parameters;
+
+      /**
+       * Reads a key from a file
+       * @param filename the file storing the key
+       */
+      explicit CppEcPublicKey(const QString &filename);
+
+      /**
+       * Loads a key from memory
+       * @param data byte array holding the key
+       */
+      explicit CppEcPublicKey(const QByteArray &data);
+
+      /**
+       * Creates a public key on the shared curve with a different base
+       * point, see CppEcGroup for the element encoding
+       * @param generator the base point g
+       * @param public_element the y of the public key (g^x)
+       */
+      explicit CppEcPublicKey(const Integer &generator,
+          const Integer &public_element);
+
+      /**
+       * Deconstructor
+       */
+      virtual ~CppEcPublicKey();
+
+      /**
+       * Creates a public key based upon the seed data, same seed data same
+       * key.  This is mainly used for distributed tests, so other members can
+       * generate an appropriate public key.
+       */
+      static CppEcPublicKey *GenerateKey(const QByteArray &data);
+
+      /**
+       * Get a copy of the public key
+       */
+      virtual AsymmetricKey *GetPublicKey() const;
+
+      virtual QByteArray GetByteArray() const;
+
+      /**
+       * Returns nothing, not supported for public keys
+       */
+      virtual QByteArray Sign(const QByteArray &data) const;
+      virtual bool Verify(const QByteArray &data, const QByteArray &sig) const;
+      virtual QByteArray Encrypt(const QByteArray &data) const;
+
+      /**
+       * Returns nothing, not supported for public keys
+       */
+      virtual QByteArray Decrypt(const QByteArray &data) const;
+
+      inline virtual bool IsPrivateKey() const { return false; }
+      virtual bool VerifyKey(AsymmetricKey &key) const;
+      inline virtual bool IsValid() const { return _valid; }
+      inline virtual int GetKeySize() const { return _key_size; }
+
+      /**
+       * ECDSA signatures are twice the size of the subgroup order
+       */
+      inline virtual int GetSignatureLength() const
+      {
+        return _valid ? int(_verifier->SignatureLength()) : 0;
+      }
+
+      /**
+       * Keys are always on the same curve, so this is the curve's size
+       */
+      static inline int GetMinimumKeySize() { return 256; }
+
+      /**
+       * Returns the curve used by all keys, NIST P-256
+       */
+      static inline CryptoPP::OID GetCurve() { return CryptoPP::ASN1::secp256r1(); }
+
+      /**
+       * Returns the encoded base point of the key
+       */
+      Integer GetGenerator() const;
+
+      /**
+       * Returns the encoded y = g^x of the key
+       */
+      Integer GetPublicElement() const;
+
+    protected:
+      typedef KeyBase::Verifier Verifier;
+      typedef EncryptionBase::Encryptor Encryptor;
+
+      /**
+       * Does not make sense to create random public keys, used by the
+       * private key
+       */
+      CppEcPublicKey() :
+        _public_key(new KeyBase::PublicKey()),
+        _valid(false),
+        _key_size(0)
+      {
+      }
+
+      /**
+       * Loads a key from the provided byte array
+       * @param data key byte array
+       */
+      bool InitFromByteArray(const QByteArray &data);
+
+      /**
+       * Loads a key from the given filename
+       * @param filename file storing the key
+       */
+      bool InitFromFile(const QString &filename);
+
+      /**
+       * Prevents a remote user from giving a malicious key, such as a point
+       * off of the curve or a key on a different curve, and builds the
+       * verifier and encryptor.  They are kept for the lifetime of the key,
+       * only used through const methods and safe to share across threads.
+       */
+      void Validate();
+
+      QScopedPointer<KeyBase::PublicKey> _public_key;
+      QScopedPointer<const Verifier> _verifier;
+      QScopedPointer<const Encryptor> _encryptor;
+      bool _valid;
+      int _key_size;
+  };
+}
+}
+
+#endif
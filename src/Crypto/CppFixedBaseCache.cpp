@@ -0,0 +1,90 @@
+#include <QDebug>
+
+#include "CppFixedBaseCache.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  QReadWriteLock CppFixedBaseCache::_lock;
+  QAtomicInt CppFixedBaseCache::_count(0);
+  QHash<quint64, QList<QSharedPointer<const CppFixedBaseTable> > >
+    CppFixedBaseCache::_tables;
+
+  quint64 CppFixedBaseCache::GetKey(const CryptoPP::Integer &modulus)
+  {
+    return quint64(modulus.GetBits(0, 32)) |
+      (quint64(modulus.BitCount()) << 32);
+  }
+
+  QSharedPointer<const CppFixedBaseTable> CppFixedBaseCache::Register(
+      const CryptoPP::Integer &base, const CryptoPP::Integer &modulus,
+      int exponent_bits)
+  {
+    if(modulus.IsEven() || modulus <= CryptoPP::Integer::One()) {
+      return QSharedPointer<const CppFixedBaseTable>();
+    }
+
+    QSharedPointer<const CppFixedBaseTable> table = Lookup(base, modulus);
+    if(table) {
+      return table;
+    }
+
+    // Build outside the lock, losing a race only wastes the table
+    table = QSharedPointer<const CppFixedBaseTable>(
+        new CppFixedBaseTable(base, modulus, exponent_bits));
+
+    QWriteLocker locker(&_lock);
+    if(_count >= MAX_ENTRIES) {
+      qWarning() << "Fixed-base table cache is full";
+      return table;
+    }
+
+    QList<QSharedPointer<const CppFixedBaseTable> > &tables =
+      _tables[GetKey(modulus)];
+    foreach(const QSharedPointer<const CppFixedBaseTable> &entry, tables) {
+      if(entry->GetBase() == table->GetBase() &&
+          entry->GetModulus() == modulus)
+      {
+        return entry;
+      }
+    }
+
+    tables.append(table);
+    _count.ref();
+    return table;
+  }
+
+  QSharedPointer<const CppFixedBaseTable> CppFixedBaseCache::Lookup(
+      const CryptoPP::Integer &base, const CryptoPP::Integer &modulus)
+  {
+    if(_count == 0) {
+      return QSharedPointer<const CppFixedBaseTable>();
+    }
+
+    QReadLocker locker(&_lock);
+    QHash<quint64, QList<QSharedPointer<const CppFixedBaseTable> > >::
+      const_iterator it = _tables.find(GetKey(modulus));
+    if(it == _tables.end()) {
+      return QSharedPointer<const CppFixedBaseTable>();
+    }
+
+    foreach(const QSharedPointer<const CppFixedBaseTable> &table, it.value()) {
+      if(table->GetBase() == base && table->GetModulus() == modulus) {
+        return table;
+      }
+    }
+    return QSharedPointer<const CppFixedBaseTable>();
+  }
+
+  void CppFixedBaseCache::Clear()
+  {
+    QWriteLocker locker(&_lock);
+    _tables.clear();
+    _count = 0;
+  }
+
+  int CppFixedBaseCache::Count()
+  {
+    return _count;
+  }
+}
+}
@@ -0,0 +1,77 @@
+#ifndef DISSENT_CRYPTO_CPP_FIXED_BASE_CACHE_H_GUARD
+#define DISSENT_CRYPTO_CPP_FIXED_BASE_CACHE_H_GUARD
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+
+#include <cryptopp/integer.h>
+
+#include "CppFixedBaseTable.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Process wide cache of fixed-base exponentiation tables for known group
+   * generators, indexed by modulus, so signers and verifiers sharing a group
+   * share one table.  Callers fetch the table once, when they learn the
+   * group, and hand it to CppInteger::Pow, keeping the lock off of every
+   * exponentiation.
+   */
+  class CppFixedBaseCache {
+    public:
+      /**
+       * Returns the table for base modulo modulus, building and caching it
+       * if one does not already exist.  Returns a null pointer for even
+       * moduli.
+       * @param base the generator
+       * @param modulus the group modulus
+       * @param exponent_bits the largest exponent to support, 0 for the
+       * size of the modulus
+       */
+      static QSharedPointer<const CppFixedBaseTable> Register(
+          const CryptoPP::Integer &base, const CryptoPP::Integer &modulus,
+          int exponent_bits = 0);
+
+      /**
+       * Returns the table for base modulo modulus or a null pointer
+       * @param base the base
+       * @param modulus the modulus
+       */
+      static QSharedPointer<const CppFixedBaseTable> Lookup(
+          const CryptoPP::Integer &base, const CryptoPP::Integer &modulus);
+
+      /**
+       * Drops all cached tables
+       */
+      static void Clear();
+
+      /**
+       * Returns the amount of cached tables
+       */
+      static int Count();
+
+      /**
+       * Maximum amount of tables held, tables registered beyond this are
+       * returned but not cached
+       */
+      static const int MAX_ENTRIES = 32;
+
+    private:
+      /**
+       * No instances of this class
+       */
+      CppFixedBaseCache() {}
+
+      static quint64 GetKey(const CryptoPP::Integer &modulus);
+
+      static QReadWriteLock _lock;
+      static QAtomicInt _count;
+      static QHash<quint64, QList<QSharedPointer<const CppFixedBaseTable> > > _tables;
+  };
+}
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "CppFixedBaseTable.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  CppFixedBaseTable::CppFixedBaseTable(const CryptoPP::Integer &base,
+      const CryptoPP::Integer &modulus, int exponent_bits, int window) :
+    _base(base % modulus),
+    _modulus(modulus),
+    _mont(modulus),
+    _window(window)
+  {
+    if(exponent_bits <= 0) {
+      exponent_bits = modulus.BitCount();
+    }
+
+    int digits = (exponent_bits + _window - 1) / _window;
+    _table.reserve(digits);
+
+    CryptoPP::Integer current = _mont.ConvertIn(_base);
+    for(int idx = 0; idx < digits; idx++) {
+      _table.append(current);
+      for(int bit = 0; bit < _window; bit++) {
+        current = _mont.Square(current);
+      }
+    }
+  }
+
+  CryptoPP::Integer CppFixedBaseTable::Exponentiate(
+      const CryptoPP::Integer &exponent) const
+  {
+    if(!Covers(exponent)) {
+      return a_exp_b_mod_c(_base, exponent, _modulus);
+    }
+
+    // MontgomeryRepresentation keeps scratch space, so each call uses its own
+    CryptoPP::MontgomeryRepresentation mont(_mont);
+
+    // Multiply each power into the bucket of its digit
+    int buckets = 1 << _window;
+    QVector<CryptoPP::Integer> bucket(buckets);
+    QVector<bool> used(buckets, false);
+
+    int digits = (exponent.BitCount() + _window - 1) / _window;
+    for(int idx = 0; idx < digits; idx++) {
+      int digit = int(exponent.GetBits(idx * _window, _window));
+      if(digit == 0) {
+        continue;
+      }
+
+      if(used[digit]) {
+        bucket[digit] = mont.Multiply(bucket[digit], _table[idx]);
+      } else {
+        bucket[digit] = _table[idx];
+        used[digit] = true;
+      }
+    }
+
+    // prod_j bucket[j]^j as a running product of suffix products
+    CryptoPP::Integer result = mont.MultiplicativeIdentity();
+    CryptoPP::Integer suffix = result;
+    bool started = false;
+    for(int digit = buckets - 1; digit > 0; digit--) {
+      if(used[digit]) {
+        suffix = started ? mont.Multiply(suffix, bucket[digit]) : bucket[digit];
+        started = true;
+      }
+      if(started) {
+        result = mont.Multiply(result, suffix);
+      }
+    }
+
+    return mont.ConvertOut(result);
+  }
+}
+}
@@ -0,0 +1,81 @@
+#ifndef DISSENT_CRYPTO_CPP_FIXED_BASE_TABLE_H_GUARD
+#define DISSENT_CRYPTO_CPP_FIXED_BASE_TABLE_H_GUARD
+
+#include <QVector>
+
+#include <cryptopp/integer.h>
+#include <cryptopp/modarith.h>
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Precomputed powers of a fixed base for modular exponentiation using the
+   * Brickell-Gordon-McCurley-Wilson method with Yao's bucket evaluation.
+   * The table holds base^(2^(w*i)) in Montgomery form, so an exponentiation
+   * by a k-bit exponent costs roughly k/w + 2^(w+1) multiplications and no
+   * squarings, instead of k squarings and k/w multiplications.  The table is
+   * immutable once constructed and may be shared across threads.
+   */
+  class CppFixedBaseTable {
+    public:
+      /**
+       * Constructor
+       * @param base the fixed base
+       * @param modulus the modulus, must be odd
+       * @param exponent_bits the largest exponent the table supports,
+       * defaults to the size of the modulus
+       * @param window the digit size in bits
+       */
+      CppFixedBaseTable(const CryptoPP::Integer &base,
+          const CryptoPP::Integer &modulus, int exponent_bits = 0,
+          int window = DEFAULT_WINDOW);
+
+      /**
+       * Returns base^exponent mod modulus, falling back to a plain modular
+       * exponentiation for exponents the table does not cover
+       * @param exponent the exponent
+       */
+      CryptoPP::Integer Exponentiate(const CryptoPP::Integer &exponent) const;
+
+      /**
+       * Returns true if the table can be used for the exponent
+       * @param exponent the exponent
+       */
+      inline bool Covers(const CryptoPP::Integer &exponent) const
+      {
+        return !exponent.IsNegative() &&
+          int(exponent.BitCount()) <= _table.count() * _window;
+      }
+
+      /**
+       * Returns the fixed base
+       */
+      inline const CryptoPP::Integer &GetBase() const { return _base; }
+
+      /**
+       * Returns the modulus
+       */
+      inline const CryptoPP::Integer &GetModulus() const { return _modulus; }
+
+      /**
+       * Returns the amount of precomputed powers
+       */
+      inline int GetTableSize() const { return _table.count(); }
+
+      /**
+       * Default digit size, 32 buckets balances table size and bucket cost
+       * for 1024 to 3072 bit exponents
+       */
+      static const int DEFAULT_WINDOW = 5;
+
+    private:
+      CryptoPP::Integer _base;
+      CryptoPP::Integer _modulus;
+      CryptoPP::MontgomeryRepresentation _mont;
+      QVector<CryptoPP::Integer> _table;
+      int _window;
+  };
+}
+}
+
+#endif
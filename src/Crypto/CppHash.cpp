@@ -1,7 +1,26 @@
+#include <QDebug>
+
+#include "CppBlake2bHash.hpp"
 #include "CppHash.hpp"
+#include "CppSha256Hash.hpp"
 
 namespace Dissent {
 namespace Crypto {
+  Hash *CppHash::Create(CryptoFactory::HashName name)
+  {
+    switch(name) {
+      case CryptoFactory::Sha256:
+        return new CppSha256Hash();
+      case CryptoFactory::Blake2b:
+        return new CppBlake2bHash();
+      case CryptoFactory::Sha1:
+        return new CppHash();
+      default:
+        qCritical() << "Invalid Hash type:" << name;
+        return new CppHash();
+    }
+  }
+
   void CppHash::Restart()
   {
     sha1.Restart();
@@ -5,6 +5,7 @@
 
 #include <cryptopp/sha.h>
 
+#include "CryptoFactory.hpp"
 #include "Hash.hpp"
 
 namespace Dissent {
@@ -19,6 +20,12 @@ namespace Crypto {
        */
       virtual ~CppHash() {}
 
+      /**
+       * Returns a new CryptoPP hash object of the given algorithm
+       * @param name the algorithm
+       */
+      static Hash *Create(CryptoFactory::HashName name);
+
       inline virtual int GetDigestSize() { return sha1.DigestSize(); }
       virtual void Restart();
       virtual void Update(const QByteArray &data);
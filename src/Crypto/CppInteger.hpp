@@ -0,0 +1,332 @@
+#ifndef DISSENT_CRYPTO_CPP_INTEGER_H_GUARD
+#define DISSENT_CRYPTO_CPP_INTEGER_H_GUARD
+
+#include <QByteArray>
+#include <QDataStream>
+
+#include <cryptopp/integer.h>
+#include <cryptopp/modarith.h>
+
+#include "CppFixedBaseTable.hpp"
+#include "CppIntegerData.hpp"
+#include "Integer.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * A non-virtual, value-type "big" integer for the CryptoPP backend.  Unlike
+   * Integer, which allocates a new IntegerData behind a virtual interface for
+   * every result, a CppInteger holds its CryptoPP::Integer inline, supports
+   * in-place compound operators and moves (or swaps) rather than copies when
+   * possible.  The byte encoding is cached until the value changes.  Intended
+   * for hot loops, convert to and from Integer at the boundaries.
+   */
+  class CppInteger {
+    public:
+      /**
+       * Construct using an int
+       * @param value the int value
+       */
+      CppInteger(int value = 0) : _integer(value), _encoded_valid(false)
+      {
+      }
+
+      /**
+       * Construct from a CryptoPP::Integer
+       * @param integer the value
+       */
+      CppInteger(const CryptoPP::Integer &integer) :
+        _integer(integer), _encoded_valid(false)
+      {
+      }
+
+      /**
+       * Construct from an Integer, shares no state with it
+       * @param integer the value
+       */
+      explicit CppInteger(const Integer &integer) :
+        _integer(CppIntegerData::GetInteger(integer)), _encoded_valid(false)
+      {
+      }
+
+      /**
+       * Construct from a big endian byte encoding
+       * @param byte_array the encoding
+       */
+      explicit CppInteger(const QByteArray &byte_array) :
+        _integer(reinterpret_cast<const byte *>(byte_array.constData()),
+            byte_array.size()),
+        _encoded_valid(false)
+      {
+      }
+
+      CppInteger(const CppInteger &other) :
+        _integer(other._integer),
+        _encoded(other._encoded),
+        _encoded_valid(other._encoded_valid)
+      {
+      }
+
+#ifdef Q_COMPILER_RVALUE_REFS
+      CppInteger(CppInteger &&other) :
+        _encoded_valid(false)
+      {
+        swap(other);
+      }
+
+      inline CppInteger &operator=(CppInteger &&other)
+      {
+        swap(other);
+        return *this;
+      }
+#endif
+
+      inline CppInteger &operator=(const CppInteger &other)
+      {
+        _integer = other._integer;
+        _encoded = other._encoded;
+        _encoded_valid = other._encoded_valid;
+        return *this;
+      }
+
+      /**
+       * Exchanges values with other without copying either
+       * @param other the other integer
+       */
+      inline void swap(CppInteger &other)
+      {
+        _integer.swap(other._integer);
+        qSwap(_encoded, other._encoded);
+        qSwap(_encoded_valid, other._encoded_valid);
+      }
+
+      /**
+       * Returns an Integer holding this value
+       */
+      inline Integer ToInteger() const
+      {
+        return Integer(new CppIntegerData(_integer));
+      }
+
+      /**
+       * Returns the underlying CryptoPP::Integer
+       */
+      inline const CryptoPP::Integer &GetCryptoInteger() const
+      {
+        return _integer;
+      }
+
+      /**
+       * Returns the big endian byte encoding, computed once per value
+       */
+      inline const QByteArray &GetByteArray() const
+      {
+        if(!_encoded_valid) {
+          int size = _integer.MinEncodedSize();
+          _encoded.resize(size);
+          _integer.Encode(reinterpret_cast<byte *>(_encoded.data()), size);
+          _encoded_valid = true;
+        }
+        return _encoded;
+      }
+
+      /**
+       * Appends the byte encoding to data, avoiding a temporary
+       * @param data the byte array to append to
+       */
+      inline void AppendByteArray(QByteArray &data) const
+      {
+        data.append(GetByteArray());
+      }
+
+      inline CppInteger &operator+=(const CppInteger &other)
+      {
+        _integer += other._integer;
+        _encoded_valid = false;
+        return *this;
+      }
+
+      inline CppInteger &operator-=(const CppInteger &other)
+      {
+        _integer -= other._integer;
+        _encoded_valid = false;
+        return *this;
+      }
+
+      inline CppInteger &operator*=(const CppInteger &other)
+      {
+        _integer *= other._integer;
+        _encoded_valid = false;
+        return *this;
+      }
+
+      inline CppInteger &operator/=(const CppInteger &other)
+      {
+        _integer /= other._integer;
+        _encoded_valid = false;
+        return *this;
+      }
+
+      inline CppInteger &operator%=(const CppInteger &mod)
+      {
+        _integer %= mod._integer;
+        _encoded_valid = false;
+        return *this;
+      }
+
+      /**
+       * this = (this * other) % mod
+       * @param other the multiplicand
+       * @param mod the modulus
+       */
+      inline CppInteger &MultiplyMod(const CppInteger &other,
+          const CppInteger &mod)
+      {
+        _integer = a_times_b_mod_c(_integer, other._integer, mod._integer);
+        _encoded_valid = false;
+        return *this;
+      }
+
+      /**
+       * Returns (this ^ pow) % mod
+       * @param pow the exponent
+       * @param mod the modulus
+       */
+      inline CppInteger Pow(const CppInteger &pow, const CppInteger &mod) const
+      {
+        return CppInteger(a_exp_b_mod_c(_integer, pow._integer, mod._integer));
+      }
+
+      /**
+       * Returns (this ^ pow) % mod using a fixed-base table built for this
+       * base and mod, callers look the table up once rather than per call
+       * @param pow the exponent
+       * @param mod the modulus
+       * @param table the table for this base or null
+       */
+      inline CppInteger Pow(const CppInteger &pow, const CppInteger &mod,
+          const CppFixedBaseTable *table) const
+      {
+        if(table && table->Covers(pow._integer)) {
+          return CppInteger(table->Exponentiate(pow._integer));
+        }
+        return Pow(pow, mod);
+      }
+
+      /**
+       * Returns (this ^ pow * base ^ base_pow) % mod with shared squarings
+       * @param pow raise this to pow
+       * @param base the second base
+       * @param base_pow raise base to base_pow
+       * @param mod modulus for the exponentiation
+       */
+      inline CppInteger CascadePow(const CppInteger &pow,
+          const CppInteger &base, const CppInteger &base_pow,
+          const CppInteger &mod) const
+      {
+        if(pow._integer.IsNegative() || base_pow._integer.IsNegative()) {
+          return Pow(pow, mod).MultiplyMod(base.Pow(base_pow, mod), mod);
+        }
+
+        CryptoPP::ModularArithmetic arith(mod._integer);
+        return CppInteger(arith.CascadeExponentiate(_integer % mod._integer,
+              pow._integer, base._integer % mod._integer, base_pow._integer));
+      }
+
+      inline bool operator==(const CppInteger &other) const
+      {
+        return _integer == other._integer;
+      }
+
+      inline bool operator!=(const CppInteger &other) const
+      {
+        return _integer != other._integer;
+      }
+
+      inline bool operator<(const CppInteger &other) const
+      {
+        return _integer < other._integer;
+      }
+
+      inline bool operator<=(const CppInteger &other) const
+      {
+        return _integer <= other._integer;
+      }
+
+      inline bool operator>(const CppInteger &other) const
+      {
+        return _integer > other._integer;
+      }
+
+      inline bool operator>=(const CppInteger &other) const
+      {
+        return _integer >= other._integer;
+      }
+
+      /**
+       * Returns the integer's count in bits
+       */
+      inline int GetBitCount() const { return _integer.BitCount(); }
+
+      /**
+       * Returns the integer's count in bytes
+       */
+      inline int GetByteCount() const { return _integer.ByteCount(); }
+
+    private:
+      CryptoPP::Integer _integer;
+      mutable QByteArray _encoded;
+      mutable bool _encoded_valid;
+  };
+
+  inline CppInteger operator+(CppInteger lhs, const CppInteger &rhs)
+  {
+    return lhs += rhs;
+  }
+
+  inline CppInteger operator-(CppInteger lhs, const CppInteger &rhs)
+  {
+    return lhs -= rhs;
+  }
+
+  inline CppInteger operator*(CppInteger lhs, const CppInteger &rhs)
+  {
+    return lhs *= rhs;
+  }
+
+  inline CppInteger operator/(CppInteger lhs, const CppInteger &rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  inline CppInteger operator%(CppInteger lhs, const CppInteger &rhs)
+  {
+    return lhs %= rhs;
+  }
+
+  /**
+   * Serialize a CppInteger in the same format as an Integer
+   * @param stream where to store the serialized integer
+   * @param value the integer to serialize
+   */
+  inline QDataStream &operator<<(QDataStream &stream, const CppInteger &value)
+  {
+    return stream << value.GetByteArray();
+  }
+
+  /**
+   * Deserialize a CppInteger in the same format as an Integer
+   * @param stream where to read data from
+   * @param value where to store the deserialized integer
+   */
+  inline QDataStream &operator>>(QDataStream &stream, CppInteger &value)
+  {
+    QByteArray tvalue;
+    stream >> tvalue;
+    CppInteger(tvalue).swap(value);
+    return stream;
+  }
+}
+}
+
+#endif
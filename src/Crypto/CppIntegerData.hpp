@@ -11,6 +11,7 @@
 #include <cryptopp/osrng.h> 
 
 #include "AsymmetricKey.hpp"
+#include "CppRandom.hpp"
 #include "Integer.hpp"
 
 #include <QSharedData>
@@ -68,7 +69,8 @@ namespace Crypto {
       static CppIntegerData *GetRandomInteger(int bit_count,
           const IntegerData *mod, bool prime)
       {
-        CryptoPP::AutoSeededX917RNG<CryptoPP::DES_EDE3> rng;
+        CryptoPP::RandomNumberGenerator &rng =
+          CppRandom::GetPooledGenerator();
 
         CryptoPP::Integer max = CppIntegerData::GetInteger(mod);
         if(max == 0) {
@@ -138,6 +140,34 @@ namespace Crypto {
               GetInteger(pow), GetInteger(mod)));
       }
 
+      /**
+       * Simultaneous exponentiation, (this^pow * base^base_pow) % mod, using
+       * CryptoPP's interleaved windowed cascade in Montgomery form
+       * @param pow raise this to pow
+       * @param base the second base
+       * @param base_pow raise base to base_pow
+       * @param mod modulus for the exponentiation
+       */
+      virtual IntegerData *CascadePow(const IntegerData *pow,
+          const IntegerData *base, const IntegerData *base_pow,
+          const IntegerData *mod) const
+      {
+        CryptoPP::Integer exponent = GetInteger(pow);
+        CryptoPP::Integer other = GetInteger(base);
+        CryptoPP::Integer other_exponent = GetInteger(base_pow);
+        CryptoPP::Integer modulus = GetInteger(mod);
+
+        if(exponent.IsNegative() || other_exponent.IsNegative()) {
+          return new CppIntegerData(a_times_b_mod_c(
+                a_exp_b_mod_c(_integer, exponent, modulus),
+                a_exp_b_mod_c(other, other_exponent, modulus), modulus));
+        }
+
+        CryptoPP::ModularArithmetic arith(modulus);
+        return new CppIntegerData(arith.CascadeExponentiate(
+              _integer % modulus, exponent, other % modulus, other_exponent));
+      }
+
       virtual IntegerData *Modulus(const IntegerData *modulus) const 
       {
         return new CppIntegerData(_integer % GetInteger(modulus));
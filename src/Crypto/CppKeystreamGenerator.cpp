@@ -0,0 +1,72 @@
+#include <string.h>
+
+#include <cryptopp/sha.h>
+
+#include "CppKeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  CppKeystreamGenerator::CppKeystreamGenerator(const QByteArray &seed,
+      const QByteArray &nonce, uint index) :
+    _position(0)
+  {
+    SetKey(seed, nonce);
+
+    if(index) {
+      Seek(index);
+    }
+  }
+
+  void CppKeystreamGenerator::SetKey(const QByteArray &seed,
+      const QByteArray &nonce)
+  {
+    byte key[CryptoPP::AES::DEFAULT_KEYLENGTH];
+    int key_size = qMin(seed.size(), int(sizeof(key)));
+    memcpy(key, seed.constData(), key_size);
+    memset(key + key_size, 0, sizeof(key) - key_size);
+
+    // The nonce fills the upper 8 bytes of the counter block, longer nonces
+    // are hashed down so that they cannot collide by folding
+    byte iv[CryptoPP::AES::BLOCKSIZE];
+    memset(iv, 0, sizeof(iv));
+    if(nonce.size() <= NONCE_SIZE) {
+      memcpy(iv, nonce.constData(), nonce.size());
+    } else {
+      byte digest[CryptoPP::SHA256::DIGESTSIZE];
+      CryptoPP::SHA256().CalculateDigest(digest,
+          reinterpret_cast<const byte *>(nonce.constData()), nonce.size());
+      memcpy(iv, digest, NONCE_SIZE);
+    }
+
+    _cipher.SetKeyWithIV(key, sizeof(key), iv);
+    _position = 0;
+    SetByteCount(_position);
+  }
+
+  void CppKeystreamGenerator::GenerateBlock(char *data, int length)
+  {
+    memset(data, 0, length);
+    XorBlock(data, length);
+  }
+
+  void CppKeystreamGenerator::XorBlock(char *data, int length)
+  {
+    XorBlock(data, data, length);
+  }
+
+  void CppKeystreamGenerator::XorBlock(char *dst, const char *src, int length)
+  {
+    _cipher.ProcessData(reinterpret_cast<byte *>(dst),
+        reinterpret_cast<const byte *>(src), length);
+    _position += length;
+    SetByteCount(_position);
+  }
+
+  void CppKeystreamGenerator::Seek(quint64 position)
+  {
+    _cipher.Seek(position);
+    _position = position;
+    SetByteCount(_position);
+  }
+}
+}
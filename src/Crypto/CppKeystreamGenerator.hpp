@@ -0,0 +1,64 @@
+#ifndef DISSENT_CRYPTO_CPP_KEYSTREAM_GENERATOR_H_GUARD
+#define DISSENT_CRYPTO_CPP_KEYSTREAM_GENERATOR_H_GUARD
+
+#include <cryptopp/aes.h>
+#include <cryptopp/modes.h>
+
+#include "KeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Implementation of KeystreamGenerator using CryptoPP AES in counter mode.
+   * CryptoPP transparently uses AES-NI when the processor supports it.  The
+   * seed is the AES key, the nonce occupies the upper half of the initial
+   * counter block and the block counter the lower half, so keystreams with
+   * different nonces never overlap.
+   */
+  class CppKeystreamGenerator : public KeystreamGenerator {
+    public:
+      using KeystreamGenerator::GenerateBlock;
+      using KeystreamGenerator::SetKey;
+      using KeystreamGenerator::XorBlock;
+
+      /**
+       * Constructor
+       * @param seed the key, padded or truncated to the AES key length
+       * @param nonce distinguishes keystreams sharing a seed, zero padded to
+       * NONCE_SIZE bytes or hashed down if longer
+       * @param index moves the keystream to a specific byte offset
+       */
+      explicit CppKeystreamGenerator(const QByteArray &seed,
+          const QByteArray &nonce = QByteArray(), uint index = 0);
+
+      /**
+       * Destructor
+       */
+      virtual ~CppKeystreamGenerator() {}
+
+      /**
+       * Returns the optimal seed size, less than will provide suboptimal
+       * results and greater than will be truncated.
+       */
+      static uint OptimalSeedSize() { return CryptoPP::AES::DEFAULT_KEYLENGTH; }
+
+      /**
+       * Bytes of the counter block holding the nonce
+       */
+      static const int NONCE_SIZE = 8;
+
+      virtual void GenerateBlock(char *data, int length);
+      virtual void XorBlock(char *data, int length);
+      virtual void XorBlock(char *dst, const char *src, int length);
+      virtual void SetKey(const QByteArray &seed, const QByteArray &nonce);
+      virtual void Seek(quint64 position);
+      inline virtual quint64 GetPosition() const { return _position; }
+
+    private:
+      CryptoPP::CTR_Mode<CryptoPP::AES>::Encryption _cipher;
+      quint64 _position;
+  };
+}
+}
+
+#endif
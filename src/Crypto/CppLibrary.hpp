@@ -4,6 +4,7 @@
 #include "CppDiffieHellman.hpp"
 #include "CppHash.hpp"
 #include "CppIntegerData.hpp"
+#include "CppKeystreamGenerator.hpp"
 #include "CppRandom.hpp"
 #include "CppPrivateKey.hpp"
 #include "CppPublicKey.hpp"
@@ -14,6 +15,8 @@ namespace Dissent {
 namespace Crypto {
   class CppLibrary : public Library {
     public:
+      using Library::GetKeystreamGenerator;
+
       /**
        * Load a public key from a file
        */
@@ -88,12 +91,23 @@ namespace Crypto {
         return CppRandom::OptimalSeedSize();
       }
 
+      /**
+       * Returns an AES counter mode keystream generator
+       * @param seed the key for the keystream
+       * @param nonce distinguishes keystreams sharing the same seed
+       */
+      inline virtual KeystreamGenerator *GetKeystreamGenerator(
+          const QByteArray &seed, const QByteArray &nonce)
+      {
+        return new CppKeystreamGenerator(seed, nonce);
+      }
+
       /**
        * Returns a hash algorithm
        */
       inline virtual Hash *GetHashAlgorithm() 
       {
-        return new CppHash();
+        return CppHash::Create(CryptoFactory::GetInstance().GetHashName());
       }
 
       /**
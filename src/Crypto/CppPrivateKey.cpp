@@ -11,6 +11,7 @@ namespace Crypto {
     _public_key = _private_key;
     _valid = InitFromFile(filename);
     _key_size = _public_key->GetModulus().BitCount();
+    InitPrivateOperations();
   }
 
   CppPrivateKey::CppPrivateKey(const QByteArray &data) :
@@ -19,17 +20,31 @@ namespace Crypto {
     _public_key = _private_key;
     _valid = InitFromByteArray(data);
     _key_size = _public_key->GetModulus().BitCount();
+    InitPrivateOperations();
   }
 
   CppPrivateKey::CppPrivateKey() :
     _private_key(new RSA::PrivateKey())
   {
     _public_key = _private_key;
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
     RSA::PrivateKey &key = const_cast<RSA::PrivateKey &>(*_private_key);
     key.GenerateRandomWithKeySize(rng, DefaultKeySize);
     _valid = true;
     _key_size = _public_key->GetModulus().BitCount();
+    InitPrivateOperations();
+  }
+
+  void CppPrivateKey::InitPrivateOperations()
+  {
+    InitPublicOperations();
+    if(!_valid) {
+      return;
+    }
+
+    const RSA::PrivateKey &private_key = *_private_key;
+    _signer.reset(new Signer(private_key));
+    _decryptor.reset(new Decryptor(private_key));
   }
 
   CppPrivateKey *CppPrivateKey::GenerateKey(const QByteArray &data)
@@ -47,10 +62,9 @@ namespace Crypto {
       return QByteArray();
     }
 
-    const RSA::PrivateKey &private_key = *_private_key;
-    RSASS<PKCS1v15, SHA>::Signer signer(private_key);
+    const Signer &signer = *_signer;
     QByteArray sig(signer.MaxSignatureLength(), 0);
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
     signer.SignMessage(rng, reinterpret_cast<const byte *>(data.data()),
         data.size(), reinterpret_cast<byte *>(sig.data()));
     return sig;
@@ -63,9 +77,8 @@ namespace Crypto {
       return QByteArray();
     }
 
-    AutoSeededX917RNG<DES_EDE3> rng;
-    const RSA::PrivateKey &private_key = *_private_key;
-    RSAES<OAEP<SHA> >::Decryptor decryptor(private_key);
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
+    const Decryptor &decryptor = *_decryptor;
 
     int data_start = decryptor.FixedCiphertextLength() + AES::BLOCKSIZE;
     int clength = data.size() - data_start;
@@ -39,7 +39,20 @@ namespace Crypto {
       inline virtual bool IsPrivateKey() const { return true; }
 
     protected:
+      /**
+       * Builds the public operations, the signer and the decryptor from a
+       * valid _private_key, see CppPublicKey::InitPublicOperations
+       */
+      void InitPrivateOperations();
+
+      typedef CryptoPP::RSASS<CryptoPP::PKCS1v15, CryptoPP::SHA>::Signer
+        Signer;
+      typedef CryptoPP::RSAES<CryptoPP::OAEP<CryptoPP::SHA> >::Decryptor
+        Decryptor;
+
       const CryptoPP::RSA::PrivateKey *_private_key;
+      QScopedPointer<const Signer> _signer;
+      QScopedPointer<const Decryptor> _decryptor;
   };
 }
 }
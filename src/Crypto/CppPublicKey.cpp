@@ -11,6 +11,7 @@ namespace Crypto {
   {
     _valid = InitFromFile(filename);
     _key_size = _public_key->GetModulus().BitCount();
+    InitPublicOperations();
   }
 
   CppPublicKey::CppPublicKey(const QByteArray &data) :
@@ -18,6 +19,7 @@ namespace Crypto {
   {
     _valid = InitFromByteArray(data);
     _key_size = _public_key->GetModulus().BitCount();
+    InitPublicOperations();
   }
 
   CppPublicKey::~CppPublicKey()
@@ -27,6 +29,17 @@ namespace Crypto {
     }
   }
 
+  void CppPublicKey::InitPublicOperations()
+  {
+    if(!_valid) {
+      return;
+    }
+
+    const RSA::PublicKey &public_key = *_public_key;
+    _verifier.reset(new Verifier(public_key));
+    _encryptor.reset(new Encryptor(public_key));
+  }
+
   CppPublicKey *CppPublicKey::GenerateKey(const QByteArray &data)
   {
     QScopedPointer<CppPrivateKey> key(CppPrivateKey::GenerateKey(data));
@@ -102,9 +115,7 @@ namespace Crypto {
       return false;
     }
 
-    const RSA::PublicKey &public_key = *_public_key;
-    RSASS<PKCS1v15, SHA>::Verifier verifier(public_key);
-    return verifier.VerifyMessage(reinterpret_cast<const byte *>(data.data()),
+    return _verifier->VerifyMessage(reinterpret_cast<const byte *>(data.data()),
         data.size(), reinterpret_cast<const byte *>(sig.data()), sig.size());
   }
 
@@ -114,13 +125,12 @@ namespace Crypto {
       return QByteArray();
     }
 
-    const RSA::PublicKey &public_key = *_public_key;
-    RSAES<OAEP<SHA> >::Encryptor encryptor(public_key);
+    const Encryptor &encryptor = *_encryptor;
     int clength = ((data.size() / AES::BLOCKSIZE) + 1) * AES::BLOCKSIZE;
     int data_start = encryptor.FixedCiphertextLength() + AES::BLOCKSIZE;
     QByteArray ciphertext(data_start + clength, 0);
 
-    AutoSeededX917RNG<DES_EDE3> rng;
+    RandomNumberGenerator &rng = CppRandom::GetPooledGenerator();
 
     SecByteBlock skey(AES::DEFAULT_KEYLENGTH);
     rng.GenerateBlock(skey, skey.size());
@@ -6,6 +6,7 @@
 #include <QByteArray>
 #include <QDebug>
 #include <QFile>
+#include <QScopedPointer>
 #include <QString>
 
 #include <cryptopp/aes.h>
@@ -91,7 +92,22 @@ namespace Crypto {
        */
       bool InitFromFile(const QString &filename);
 
+      /**
+       * Builds the verifier and encryptor from a valid _public_key, they are
+       * kept for the lifetime of the key so that repeated operations skip
+       * the setup.  Both are only used through const methods and are safe to
+       * share across threads.
+       */
+      void InitPublicOperations();
+
+      typedef CryptoPP::RSASS<CryptoPP::PKCS1v15, CryptoPP::SHA>::Verifier
+        Verifier;
+      typedef CryptoPP::RSAES<CryptoPP::OAEP<CryptoPP::SHA> >::Encryptor
+        Encryptor;
+
       const CryptoPP::RSA::PublicKey *_public_key;
+      QScopedPointer<const Verifier> _verifier;
+      QScopedPointer<const Encryptor> _encryptor;
       bool _valid;
       int _key_size;
   };
@@ -1,16 +1,59 @@
 #include <QDebug>
+#include <QThreadStorage>
+
 #include "CppRandom.hpp"
 
 namespace Dissent {
 namespace Crypto {
+namespace {
+  /**
+   * Per thread generator, reseeds itself from the OS after a fixed amount
+   * of output
+   */
+  class PooledGenerator : public CryptoPP::RandomNumberGenerator {
+    public:
+      PooledGenerator() : _generated(0)
+      {
+        try {
+          _rng.reset(new CryptoPP::AutoSeededX917RNG<CryptoPP::AES>());
+        } catch (CryptoPP::OS_RNG_Err &ex) {
+          qFatal("Ran out of file descriptors, when creating a CppRandom.");
+        }
+      }
+
+      virtual void GenerateBlock(byte *output, size_t size)
+      {
+        if(_generated >= size_t(CppRandom::RESEED_BYTES)) {
+          try {
+            _rng->Reseed();
+          } catch (CryptoPP::OS_RNG_Err &ex) {
+            qFatal("Ran out of file descriptors, when reseeding a CppRandom.");
+          }
+          _generated = 0;
+        }
+
+        _rng->GenerateBlock(output, size);
+        _generated += size;
+      }
+
+    private:
+      QScopedPointer<CryptoPP::AutoSeededX917RNG<CryptoPP::AES> > _rng;
+      size_t _generated;
+  };
+}
+
+  CryptoPP::RandomNumberGenerator &CppRandom::GetPooledGenerator()
+  {
+    static QThreadStorage<PooledGenerator *> generators;
+    if(!generators.hasLocalData()) {
+      generators.setLocalData(new PooledGenerator());
+    }
+    return *generators.localData();
+  }
+
   CppRandom::CppRandom(const QByteArray &seed, uint index)
   {
     if(seed.isEmpty()) {
-      try {
-        _rng.reset(new CryptoPP::AutoSeededX917RNG<CryptoPP::AES>());
-      } catch (CryptoPP::OS_RNG_Err &ex) {
-        qFatal("Ran out of file descriptors, when creating a CppRandom.");
-      }
       return;
     }
 
@@ -41,12 +84,13 @@ namespace Crypto {
       return min;
     }
     IncrementByteCount(4);
-    return _rng->GenerateWord32(min, max - 1);
+    return GetHandle()->GenerateWord32(min, max - 1);
   }
 
   void CppRandom::GenerateBlock(QByteArray &data)
   {
-    _rng->GenerateBlock(reinterpret_cast<byte *>(data.data()), data.size());
+    GetHandle()->GenerateBlock(reinterpret_cast<byte *>(data.data()),
+        data.size());
     IncrementByteCount(data.size());
   }
 }
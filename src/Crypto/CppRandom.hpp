@@ -9,7 +9,9 @@
 namespace Dissent {
 namespace Crypto {
   /**
-   * Implementation of Random using CryptoPP
+   * Implementation of Random using CryptoPP.  Unseeded instances draw from
+   * a per thread generator pool, so creating one does not touch the OS
+   * entropy source.
    */
   class CppRandom : public Utils::Random {
     public:
@@ -32,7 +34,29 @@ namespace Crypto {
 
       virtual int GetInt(int min = 0, int max = RAND_MAX);
       virtual void GenerateBlock(QByteArray &data);
-      CryptoPP::RandomNumberGenerator *GetHandle() { return _rng.data(); }
+
+      /**
+       * Returns the underlying generator, for unseeded instances the pooled
+       * generator of the calling thread
+       */
+      CryptoPP::RandomNumberGenerator *GetHandle()
+      {
+        return _rng ? _rng.data() : &GetPooledGenerator();
+      }
+
+      /**
+       * Returns the calling thread's cryptographically secure generator.
+       * It is seeded from the OS on first use and reseeded every
+       * RESEED_BYTES, use it instead of constructing AutoSeeded generators
+       * on hot paths.  Must only be used from the calling thread.
+       */
+      static CryptoPP::RandomNumberGenerator &GetPooledGenerator();
+
+      /**
+       * Amount of output after which a pooled generator reseeds
+       */
+      static const int RESEED_BYTES = 1024 * 1024;
+
     private:
       QScopedPointer<CryptoPP::RandomNumberGenerator> _rng;
   };
@@ -0,0 +1,30 @@
+#include "CppSha256Hash.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  void CppSha256Hash::Restart()
+  {
+    _sha256.Restart();
+  }
+
+  void CppSha256Hash::Update(const QByteArray &data)
+  {
+    _sha256.Update(reinterpret_cast<const byte *>(data.data()), data.size());
+  }
+
+  QByteArray CppSha256Hash::ComputeHash()
+  {
+    QByteArray hash(GetDigestSize(), 0);
+    _sha256.Final(reinterpret_cast<byte *>(hash.data()));
+    return hash;
+  }
+
+  QByteArray CppSha256Hash::ComputeHash(const QByteArray &data)
+  {
+    QByteArray hash(GetDigestSize(), 0);
+    _sha256.CalculateDigest(reinterpret_cast<byte *>(hash.data()),
+        reinterpret_cast<const byte *>(data.data()), data.size());
+    return hash;
+  }
+}
+}
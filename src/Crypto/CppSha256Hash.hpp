@@ -0,0 +1,34 @@
+#ifndef DISSENT_CRYPTO_CPP_SHA256_HASH_H_GUARD
+#define DISSENT_CRYPTO_CPP_SHA256_HASH_H_GUARD
+
+#include <QByteArray>
+
+#include <cryptopp/sha.h>
+
+#include "Hash.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Hash wrapper for CryptoPP::SHA256, which CryptoPP runs on the SHA
+   * extensions where the processor has them
+   */
+  class CppSha256Hash : public Hash {
+    public:
+      /**
+       * Destructor
+       */
+      virtual ~CppSha256Hash() {}
+
+      inline virtual int GetDigestSize() { return _sha256.DigestSize(); }
+      virtual void Restart();
+      virtual void Update(const QByteArray &data);
+      virtual QByteArray ComputeHash();
+      virtual QByteArray ComputeHash(const QByteArray &data);
+    private:
+      CryptoPP::SHA256 _sha256;
+  };
+}
+}
+
+#endif
@@ -1,7 +1,9 @@
 #include <QDebug>
+#include <QThread>
 
 #include "CppLibrary.hpp"
 #include "CppDsaLibrary.hpp"
+#include "CppEcLibrary.hpp"
 #include "NullLibrary.hpp"
 #include "CryptoFactory.hpp"
 #include "ThreadedOnionEncryptor.hpp"
@@ -18,9 +20,26 @@ namespace Crypto {
     _library(new CppLibrary()),
     _onion(new OnionEncryptor()),
     _library_name(CryptoPP),
+    _hash_name(Sha1),
+    _generation(0),
     _threading_type(SingleThreaded),
-    _previous(0)
+    _previous(0),
+    _thread_count(1)
   {
+    GetScheduler().SetThreadCount(_thread_count);
+  }
+
+  void CryptoFactory::SetThreadCount(int count)
+  {
+    if(count < 0) {
+      qCritical() << "Invalid thread count:" << count;
+      count = 1;
+    } else if(count == 0) {
+      count = qMax(1, QThread::idealThreadCount());
+    }
+
+    _thread_count = count;
+    GetScheduler().SetThreadCount(_thread_count);
   }
 
   void CryptoFactory::SetThreading(ThreadingType type)
@@ -54,16 +73,56 @@ namespace Crypto {
       case CryptoPPDsa:
         _library.reset(new CppDsaLibrary());
         break;
+      case CryptoPPEc:
+        _library.reset(new CppEcLibrary());
+        break;
       case Null:
         _library.reset(new NullLibrary());
         break;
       default:
         qCritical() << "Invalid Library type:" << type;
         _library.reset(new CppLibrary());
+        type = CryptoPP;
     }
 
+    _library_name = type;
+    _generation.ref();
+
     AsymmetricKey::DefaultKeySize = std::max(_library->MinimumKeySize(),
         AsymmetricKey::DefaultKeySize);
   }
+
+  void CryptoFactory::SetHash(HashName name)
+  {
+    switch(name) {
+      case Sha1:
+      case Sha256:
+      case Blake2b:
+        _hash_name = name;
+        break;
+      default:
+        qCritical() << "Invalid Hash type:" << name;
+        _hash_name = Sha1;
+    }
+    _generation.ref();
+  }
+
+  Hash &CryptoFactory::GetThreadHash()
+  {
+    int generation = _generation;
+    if(!_thread_hashes.hasLocalData()) {
+      _thread_hashes.setLocalData(new ThreadHash());
+      _thread_hashes.localData()->generation = generation - 1;
+    }
+
+    ThreadHash *thread_hash = _thread_hashes.localData();
+    if(thread_hash->generation != generation) {
+      thread_hash->hash.reset(_library->GetHashAlgorithm());
+      thread_hash->generation = generation;
+    } else {
+      thread_hash->hash->Restart();
+    }
+    return *thread_hash->hash;
+  }
 }
 }
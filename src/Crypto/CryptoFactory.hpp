@@ -1,7 +1,12 @@
 #ifndef DISSENT_CRYPTO_CRYPTO_FACTORY_H_GUARD
 #define DISSENT_CRYPTO_CRYPTO_FACTORY_H_GUARD
 
+#include <QAtomicInt>
 #include <QScopedPointer>
+#include <QThreadStorage>
+
+#include "Utils/TaskScheduler.hpp"
+
 #include "OnionEncryptor.hpp"
 #include "Library.hpp"
 
@@ -17,9 +22,16 @@ namespace Crypto {
       enum LibraryName {
         CryptoPP,
         CryptoPPDsa,
+        CryptoPPEc,
         Null
       };
 
+      enum HashName {
+        Sha1,
+        Sha256,
+        Blake2b
+      };
+
       /**
        * Returns a reference to the singleton
        */
@@ -35,6 +47,27 @@ namespace Crypto {
        */
       inline ThreadingType GetThreadingType() { return _threading_type; }
 
+      /**
+       * Sets the amount of threads used for parallel crypto work, such as
+       * DC-net pad generation
+       * @param count the amount of threads, 0 uses one per core
+       */
+      void SetThreadCount(int count);
+
+      /**
+       * Returns the amount of threads used for parallel crypto work
+       */
+      inline int GetThreadCount() { return _thread_count; }
+
+      /**
+       * Returns the scheduler that runs threaded crypto work, sized by
+       * SetThreadCount
+       */
+      inline Utils::TaskScheduler &GetScheduler()
+      {
+        return Utils::TaskScheduler::GetInstance();
+      }
+
       /**
        * Sets the library used
        */
@@ -45,6 +78,32 @@ namespace Crypto {
        */
       inline LibraryName GetLibraryName() { return _library_name; }
 
+      /**
+       * Sets the hash algorithm returned by the CryptoPP libraries, all
+       * members must use the same one.  The Null library always uses its
+       * own hash.
+       */
+      void SetHash(HashName name);
+
+      /**
+       * Returns the current hash algorithm name
+       */
+      inline HashName GetHashName() { return _hash_name; }
+
+      /**
+       * Returns a hash object owned by the calling thread, restarted and
+       * matching the current library and hash algorithm.  Saves allocating
+       * one per use on hot paths, but must not be held across calls that
+       * may use it too.
+       */
+      Hash &GetThreadHash();
+
+      /**
+       * Returns a counter bumped whenever the library or hash changes, so
+       * per-thread objects built from the library know to rebuild
+       */
+      inline int GetGeneration() const { return _generation; }
+
       /**
        * Return the Onion Encryptor
        */
@@ -75,9 +134,21 @@ namespace Crypto {
        * No copying of singleton objects
        */
       Q_DISABLE_COPY(CryptoFactory)
+      /**
+       * A thread's hash object and the configuration it was created for
+       */
+      struct ThreadHash {
+        QScopedPointer<Hash> hash;
+        int generation;
+      };
+
       LibraryName _library_name;
+      HashName _hash_name;
+      QAtomicInt _generation;
+      QThreadStorage<ThreadHash *> _thread_hashes;
       ThreadingType _threading_type;
       int _previous;
+      int _thread_count;
   };
 }
 }
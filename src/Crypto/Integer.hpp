@@ -127,6 +127,22 @@ namespace Crypto {
         return Integer(_data->Pow(pow._data.constData(), mod._data.constData()));
       }
 
+      /**
+       * Simultaneous exponentiation, (this^pow * base^base_pow) % mod, costs
+       * little more than a single exponentiation
+       * @param pow raise this to pow
+       * @param base the second base
+       * @param base_pow raise base to base_pow
+       * @param mod modulus for the exponentiation
+       */
+      Integer CascadePow(const Integer &pow, const Integer &base,
+          const Integer &base_pow, const Integer &mod) const
+      {
+        return Integer(_data->CascadePow(pow._data.constData(),
+              base._data.constData(), base_pow._data.constData(),
+              mod._data.constData()));
+      }
+
       /**
        * Assignment operator
        * @param other the other Integer
@@ -92,6 +92,18 @@ namespace Crypto {
       virtual IntegerData *Pow(const IntegerData *pow,
           const IntegerData *mod) const = 0;
 
+      /**
+       * Simultaneous exponentiation, (this^pow * base^base_pow) % mod,
+       * sharing the squarings between both exponentiations
+       * @param pow raise this to pow
+       * @param base the second base
+       * @param base_pow raise base to base_pow
+       * @param mod modulus for the exponentiation
+       */
+      virtual IntegerData *CascadePow(const IntegerData *pow,
+          const IntegerData *base, const IntegerData *base_pow,
+          const IntegerData *mod) const = 0;
+
       /**
        * Assignment operator
        * @param other the IntegerData to use for setting
@@ -0,0 +1,110 @@
+#ifndef DISSENT_CRYPTO_KEYSTREAM_GENERATOR_H_GUARD
+#define DISSENT_CRYPTO_KEYSTREAM_GENERATOR_H_GUARD
+
+#include <QByteArray>
+
+#include "Utils/Random.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * A deterministic, seekable keystream, such as a block cipher in counter
+   * mode.  Unlike a generic Random, any byte offset in the stream can be
+   * reached in constant time and output can be written (or xored) directly
+   * into a caller provided buffer, making it suitable for DC-net pads and
+   * for replaying pads during blame.
+   */
+  class KeystreamGenerator : public Utils::Random {
+    public:
+      /**
+       * Destructor
+       */
+      virtual ~KeystreamGenerator() {}
+
+      /**
+       * Writes the next length bytes of keystream into data
+       * @param data the output buffer
+       * @param length the amount of bytes to write
+       */
+      virtual void GenerateBlock(char *data, int length) = 0;
+
+      /**
+       * Xors the next length bytes of keystream into data
+       * @param data the buffer to xor the keystream into
+       * @param length the amount of bytes to xor
+       */
+      virtual void XorBlock(char *data, int length) = 0;
+
+      /**
+       * Writes src xored with the next length bytes of keystream into dst,
+       * src and dst may be the same buffer
+       * @param dst the output buffer
+       * @param src the input buffer
+       * @param length the amount of bytes to process
+       */
+      virtual void XorBlock(char *dst, const char *src, int length) = 0;
+
+      /**
+       * Rekeys the keystream in place and moves it to offset 0, reusing the
+       * existing cipher context rather than constructing a new generator
+       * @param seed the new key for the keystream
+       * @param nonce distinguishes keystreams sharing a seed
+       */
+      virtual void SetKey(const QByteArray &seed,
+          const QByteArray &nonce) = 0;
+
+      /**
+       * Rekeys the keystream in place with an empty nonce
+       * @param seed the new key for the keystream
+       */
+      inline void SetKey(const QByteArray &seed) { SetKey(seed, QByteArray()); }
+
+      /**
+       * Moves the keystream to the specified byte offset
+       * @param position the byte offset
+       */
+      virtual void Seek(quint64 position) = 0;
+
+      /**
+       * Returns the current byte offset into the keystream
+       */
+      virtual quint64 GetPosition() const = 0;
+
+      /**
+       * Overwrites data with the next data.size() bytes of keystream
+       * @param data QByteArray to generate the keystream inside
+       */
+      virtual void GenerateBlock(QByteArray &data)
+      {
+        GenerateBlock(data.data(), data.size());
+      }
+
+      /**
+       * Xors the next data.size() bytes of keystream into data
+       * @param data the byte array to xor the keystream into
+       */
+      inline void XorBlock(QByteArray &data)
+      {
+        XorBlock(data.data(), data.size());
+      }
+
+      /**
+       * Returns a random intger from min to max
+       * @param min the inclusive minimum value
+       * @param max the exclusive maximum value
+       */
+      virtual int GetInt(int min = 0, int max = RAND_MAX)
+      {
+        if(max <= min) {
+          return min;
+        }
+
+        quint32 value;
+        GenerateBlock(reinterpret_cast<char *>(&value), sizeof(value));
+        return min + int(value % quint32(max - min));
+      }
+  };
+}
+}
+
+#endif
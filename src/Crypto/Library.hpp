@@ -6,6 +6,7 @@
 #include "DiffieHellman.hpp"
 #include "Hash.hpp"
 #include "IntegerData.hpp"
+#include "KeystreamGenerator.hpp"
 
 namespace Dissent {
 namespace Crypto {
@@ -62,6 +63,24 @@ namespace Crypto {
        */
       virtual uint RngOptimalSeedSize() = 0;
 
+      /**
+       * Returns a seekable keystream generator, the deterministic output is
+       * suitable for DC-net pads and can be replayed from any byte offset
+       * @param seed the key for the keystream
+       * @param nonce distinguishes keystreams sharing the same seed
+       */
+      virtual KeystreamGenerator *GetKeystreamGenerator(const QByteArray &seed,
+          const QByteArray &nonce) = 0;
+
+      /**
+       * Returns a seekable keystream generator with an empty nonce
+       * @param seed the key for the keystream
+       */
+      inline KeystreamGenerator *GetKeystreamGenerator(const QByteArray &seed)
+      {
+        return GetKeystreamGenerator(seed, QByteArray());
+      }
+
       /**
        * Returns a hash algorithm
        */
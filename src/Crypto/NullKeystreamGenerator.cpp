@@ -0,0 +1,78 @@
+#include <string.h>
+
+#include "NullKeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  NullKeystreamGenerator::NullKeystreamGenerator(const QByteArray &seed,
+      const QByteArray &nonce, uint index) :
+    _key(0),
+    _position(0)
+  {
+    SetKey(seed, nonce);
+    Seek(index);
+  }
+
+  void NullKeystreamGenerator::SetKey(const QByteArray &seed,
+      const QByteArray &nonce)
+  {
+    _key = 0;
+    for(int idx = 0; idx < seed.size(); idx++) {
+      _key ^= quint64(quint8(seed[idx])) << (8 * (idx % 8));
+    }
+
+    // Chain the nonce's 8 byte words through the mix, so long nonces do
+    // not collide by folding
+    quint64 nkey = 0;
+    for(int idx = 0; idx < nonce.size(); idx++) {
+      if(idx > 0 && idx % 8 == 0) {
+        nkey = Block(nkey);
+      }
+      nkey ^= quint64(quint8(nonce[idx])) << (8 * (idx % 8));
+    }
+    _key ^= Block(nkey);
+
+    Seek(0);
+  }
+
+  quint64 NullKeystreamGenerator::Block(quint64 index) const
+  {
+    // SplitMix64 finalizer
+    quint64 z = _key + (index + 1) * Q_UINT64_C(0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+  }
+
+  void NullKeystreamGenerator::GenerateBlock(char *data, int length)
+  {
+    memset(data, 0, length);
+    XorBlock(data, length);
+  }
+
+  void NullKeystreamGenerator::XorBlock(char *data, int length)
+  {
+    XorBlock(data, data, length);
+  }
+
+  void NullKeystreamGenerator::XorBlock(char *dst, const char *src, int length)
+  {
+    int idx = 0;
+    while(idx < length) {
+      quint64 block = Block(_position / 8);
+      for(int offset = _position % 8; offset < 8 && idx < length; offset++) {
+        dst[idx] = src[idx] ^ char(block >> (8 * offset));
+        idx++;
+        _position++;
+      }
+    }
+    SetByteCount(_position);
+  }
+
+  void NullKeystreamGenerator::Seek(quint64 position)
+  {
+    _position = position;
+    SetByteCount(_position);
+  }
+}
+}
@@ -0,0 +1,48 @@
+#ifndef DISSENT_CRYPTO_NULL_KEYSTREAM_GENERATOR_H_GUARD
+#define DISSENT_CRYPTO_NULL_KEYSTREAM_GENERATOR_H_GUARD
+
+#include "KeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * A fast, insecure keystream for the Null library: each 8 byte block is a
+   * 64-bit mix of the seed, the nonce and the block index.
+   */
+  class NullKeystreamGenerator : public KeystreamGenerator {
+    public:
+      using KeystreamGenerator::GenerateBlock;
+      using KeystreamGenerator::SetKey;
+      using KeystreamGenerator::XorBlock;
+
+      /**
+       * Constructor
+       * @param seed the key for the keystream
+       * @param nonce distinguishes keystreams sharing a seed
+       * @param index moves the keystream to a specific byte offset
+       */
+      explicit NullKeystreamGenerator(const QByteArray &seed,
+          const QByteArray &nonce = QByteArray(), uint index = 0);
+
+      /**
+       * Destructor
+       */
+      virtual ~NullKeystreamGenerator() {}
+
+      virtual void GenerateBlock(char *data, int length);
+      virtual void XorBlock(char *data, int length);
+      virtual void XorBlock(char *dst, const char *src, int length);
+      virtual void SetKey(const QByteArray &seed, const QByteArray &nonce);
+      virtual void Seek(quint64 position);
+      inline virtual quint64 GetPosition() const { return _position; }
+
+    private:
+      quint64 Block(quint64 index) const;
+
+      quint64 _key;
+      quint64 _position;
+  };
+}
+}
+
+#endif
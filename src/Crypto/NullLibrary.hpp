@@ -3,6 +3,7 @@
 
 #include "NullDiffieHellman.hpp"
 #include "NullHash.hpp"
+#include "NullKeystreamGenerator.hpp"
 #include "Utils/Random.hpp"
 #include "NullPrivateKey.hpp"
 #include "NullPublicKey.hpp"
@@ -14,6 +15,8 @@ namespace Dissent {
 namespace Crypto {
   class NullLibrary : public Library {
     public:
+      using Library::GetKeystreamGenerator;
+
       /**
        * Load a public key from a file
        */
@@ -88,6 +91,17 @@ namespace Crypto {
         return Utils::Random::OptimalSeedSize();
       }
 
+      /**
+       * Returns an insecure, fast keystream generator
+       * @param seed the key for the keystream
+       * @param nonce distinguishes keystreams sharing the same seed
+       */
+      inline virtual KeystreamGenerator *GetKeystreamGenerator(
+          const QByteArray &seed, const QByteArray &nonce)
+      {
+        return new NullKeystreamGenerator(seed, nonce);
+      }
+
       /**
        * Returns a hash algorithm
        */
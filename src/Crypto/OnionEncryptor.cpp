@@ -66,19 +66,41 @@ namespace Crypto {
     return res;
   }
 
+  bool OnionEncryptor::DecryptWithDigests(const QSharedPointer<AsymmetricKey> &key,
+      const QVector<QByteArray> &ciphertext, QVector<QByteArray> &cleartext,
+      QVector<QByteArray> &digests, QVector<int> *bad) const
+  {
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    cleartext.clear();
+    digests.clear();
+    bool res = true;
+    for(int idx = 0; idx < ciphertext.count(); idx++) {
+      QByteArray data = key->Decrypt(ciphertext[idx]);
+      if(data.isEmpty()) {
+        res = false;
+        if(bad) {
+          bad->append(idx);
+        }
+      }
+      cleartext.append(data);
+      digests.append(cf.GetThreadHash().ComputeHash(ciphertext[idx]));
+    }
+    return res;
+  }
+
   void OnionEncryptor::RandomizeBlocks(QVector<QByteArray> &text) const
   {
     Library *lib = CryptoFactory::GetInstance().GetLibrary();
     QScopedPointer<Dissent::Utils::Random> rand(lib->GetRandomNumberGenerator());
 
-    for(int idx = 0; idx < text.count(); idx++) {
-      int jdx = rand->GetInt(0, text.count());
+    // Swapping with any index in [0, count) is biased, only swap with the
+    // blocks not yet placed
+    for(int idx = text.count() - 1; idx > 0; idx--) {
+      int jdx = rand->GetInt(0, idx + 1);
       if(jdx == idx) {
         continue;
       }
-      QByteArray tmp = text[idx];
-      text[idx] = text[jdx];
-      text[jdx] = tmp;
+      qSwap(text[idx], text[jdx]);
     }
   }
 
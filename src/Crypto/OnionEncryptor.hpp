@@ -40,7 +40,22 @@ namespace Crypto {
           QVector<QByteArray> &cleartext, QVector<int> *bad = 0) const;
 
       /**
-       * Randomizes the inpuptted message blocks
+       * Like Decrypt, but also returns a digest of each ciphertext computed
+       * alongside its decryption, useful for finding duplicates without
+       * comparing every pair of ciphertexts
+       * @param key the private key used for decryption
+       * @param ciphertext the set of data to decrypt
+       * @param cleartext the resulting cleartext
+       * @param digests the resulting digest of each ciphertext
+       * @param bad optionally returns index of malformed messages
+       */
+      virtual bool DecryptWithDigests(const QSharedPointer<AsymmetricKey> &key,
+          const QVector<QByteArray> &ciphertext,
+          QVector<QByteArray> &cleartext, QVector<QByteArray> &digests,
+          QVector<int> *bad = 0) const;
+
+      /**
+       * Uniformly permutes the inputted message blocks (Fisher-Yates)
        * @param text the message blocks
        */
       void RandomizeBlocks(QVector<QByteArray> &text) const;
@@ -52,7 +67,7 @@ namespace Crypto {
        * @param cleartext the unencrypted data
        * @param ciphertext the encrypted data
        */
-      bool VerifyOne(const QSharedPointer<AsymmetricKey> &key,
+      virtual bool VerifyOne(const QSharedPointer<AsymmetricKey> &key,
           const QVector<QByteArray> &cleartext,
           const QVector<QByteArray> &ciphertext) const;
 
@@ -65,7 +80,7 @@ namespace Crypto {
        * encrypted and the maximum index being the most encrypted
        * @param bad indexes are set if the key had issue decrypting
        */
-      bool VerifyAll(const QVector<QSharedPointer<AsymmetricKey> > &keys,
+      virtual bool VerifyAll(const QVector<QSharedPointer<AsymmetricKey> > &keys,
           const QVector<QVector<QByteArray> > &onion,
           QBitArray &bad) const;
 
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <QRunnable>
+
+#include "Utils/XorKernel.hpp"
+
+#include "CryptoFactory.hpp"
+#include "PadCache.hpp"
+#include "PadGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+namespace {
+  /**
+   * Generates the pad of a single keystream into a preallocated buffer
+   */
+  class PrecomputeTask : public QRunnable {
+    public:
+      PrecomputeTask(const QSharedPointer<KeystreamGenerator> &rng,
+          char *output, int length, const Utils::TaskGroup *group,
+          QSemaphore &done) :
+        _rng(rng), _output(output), _length(length), _group(group),
+        _done(done)
+      {
+      }
+
+      virtual void run()
+      {
+        if(!_group || !_group->IsCancelled()) {
+          _rng->GenerateBlock(_output, _length);
+        }
+        _done.release();
+      }
+
+    private:
+      QSharedPointer<KeystreamGenerator> _rng;
+      char *_output;
+      int _length;
+      const Utils::TaskGroup *_group;
+      QSemaphore &_done;
+  };
+}
+
+  PadCache::PadCache(qint64 max_bytes,
+      const QSharedPointer<Utils::TaskGroup> &group) :
+    _max_bytes(max_bytes),
+    _group(group),
+    _length(0),
+    _cached(0),
+    _pending(0)
+  {
+  }
+
+  PadCache::~PadCache()
+  {
+    Wait();
+  }
+
+  void PadCache::Precompute(
+      const QHash<int, QSharedPointer<KeystreamGenerator> > &rngs, int length)
+  {
+    Clear();
+
+    _length = length;
+    QHash<int, QSharedPointer<KeystreamGenerator> >::const_iterator it;
+    for(it = rngs.constBegin(); it != rngs.constEnd(); ++it) {
+      _indexes[it.key()] = _rngs.count();
+      _rngs.append(it.value());
+      _starts.append(it.value()->GetPosition());
+    }
+
+    if(_length <= 0 || _rngs.isEmpty()) {
+      return;
+    }
+
+    _cached = int(std::min(qint64(_rngs.count()), _max_bytes / _length));
+    if(_cached == 0) {
+      return;
+    }
+
+    // Buffers are allocated here so the workers never touch the containers
+    _pads.resize(_cached);
+    for(int idx = 0; idx < _cached; idx++) {
+      _pads[idx] = QByteArray(_length, 0);
+    }
+
+    Utils::TaskScheduler &scheduler =
+      CryptoFactory::GetInstance().GetScheduler();
+
+    // One task per keystream, so a pool thread is never held for longer
+    // than a single pad and critical work queued meanwhile runs next.
+    // Wait blocks on these, so they are not dropped with the group but
+    // check it themselves
+    for(int idx = 0; idx < _cached; idx++) {
+      scheduler.Start(new PrecomputeTask(_rngs[idx], _pads[idx].data(), _length,
+            _group.data(), _done), Utils::TaskScheduler::Background);
+    }
+    _pending = _cached;
+  }
+
+  int PadCache::XorPads(const QList<int> &keys, QByteArray &pad)
+  {
+    Wait();
+
+    bool reuse = (pad.size() == _length);
+    QList<QByteArray> cached;
+    PadGenerator::KeystreamList uncached;
+    int count = 0;
+
+    foreach(int key, keys) {
+      int idx = _indexes.value(key, -1);
+      if(idx == -1) {
+        continue;
+      }
+
+      count++;
+      if(reuse && idx < _cached) {
+        cached.append(_pads[idx]);
+        continue;
+      }
+
+      if(idx < _cached) {
+        _rngs[idx]->Seek(_starts[idx]);
+      }
+      uncached.append(_rngs[idx]);
+    }
+
+    Utils::XorKernel::XorMany(pad, cached);
+    PadGenerator::XorPads(uncached, pad);
+
+    Clear();
+    return count;
+  }
+
+  void PadCache::Clear()
+  {
+    Wait();
+    _length = 0;
+    _cached = 0;
+    _indexes.clear();
+    _rngs.clear();
+    _starts.clear();
+    _pads.clear();
+  }
+
+  void PadCache::Wait()
+  {
+    if(_pending > 0) {
+      _done.acquire(_pending);
+      _pending = 0;
+    }
+  }
+}
+}
@@ -0,0 +1,106 @@
+#ifndef DISSENT_CRYPTO_PAD_CACHE_H_GUARD
+#define DISSENT_CRYPTO_PAD_CACHE_H_GUARD
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "Utils/TaskScheduler.hpp"
+
+#include "KeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Precomputes DC-net pads in the background.  Once the keystreams for an
+   * upcoming phase are known, each keystream's pad is generated on the
+   * CryptoFactory thread pool and held until the set of participating
+   * keystreams is known, at which point only the selected pads are xored
+   * together.  The cache is bounded, keystreams that do not fit are
+   * generated on demand.  Precomputation runs at background priority, one
+   * task per keystream so critical work is not starved, and stops early
+   * once the owner's task group is cancelled.
+   */
+  class PadCache {
+    public:
+      /**
+       * Constructor
+       * @param max_bytes the maximum amount of pad bytes to hold
+       * @param group optional task group of the owner, once cancelled the
+       * remaining precomputation is abandoned and the cache must not be
+       * used further
+       */
+      explicit PadCache(qint64 max_bytes = DEFAULT_MAX_BYTES,
+          const QSharedPointer<Utils::TaskGroup> &group =
+            QSharedPointer<Utils::TaskGroup>());
+
+      /**
+       * Destructor, waits for any outstanding precomputation
+       */
+      ~PadCache();
+
+      /**
+       * Discards the current contents and begins generating length bytes of
+       * pad for each keystream in the background
+       * @param rngs the keystreams, indexed by a caller chosen key, each
+       * should be positioned at the start of the pad
+       * @param length the length of the pad
+       */
+      void Precompute(const QHash<int, QSharedPointer<KeystreamGenerator> > &rngs,
+          int length);
+
+      /**
+       * Xors the pads of the specified keys into pad, waiting for the
+       * precomputation if necessary, and then empties the cache.  If pad is
+       * not the precomputed length, the keystreams are rewound and
+       * regenerated.  Keys not passed to Precompute are ignored.
+       * @param keys the participating keys
+       * @param pad the accumulator
+       * @returns the amount of keys whose pads were xored into pad
+       */
+      int XorPads(const QList<int> &keys, QByteArray &pad);
+
+      /**
+       * Waits for any outstanding precomputation and empties the cache
+       */
+      void Clear();
+
+      /**
+       * Returns the amount of keystreams whose pads are (being) cached
+       */
+      inline int GetCachedCount() const { return _cached; }
+
+      /**
+       * Returns the maximum amount of pad bytes held
+       */
+      inline qint64 GetMaxBytes() const { return _max_bytes; }
+
+      /**
+       * By default hold up to 64 MB of pads
+       */
+      static const qint64 DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    private:
+      /**
+       * Waits for the background tasks to finish
+       */
+      void Wait();
+
+      qint64 _max_bytes;
+      QSharedPointer<Utils::TaskGroup> _group;
+      int _length;
+      int _cached;
+      int _pending;
+      QSemaphore _done;
+      QHash<int, int> _indexes;
+      QVector<QSharedPointer<KeystreamGenerator> > _rngs;
+      QVector<quint64> _starts;
+      QVector<QByteArray> _pads;
+  };
+}
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include <algorithm>
+
+#include "Utils/XorKernel.hpp"
+
+#include "CryptoFactory.hpp"
+#include "PadGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+namespace {
+  /**
+   * Accumulates keystreams into the pad for the calling thread's range and
+   * into a private buffer for each other range
+   */
+  class PadJob : public Utils::TaskScheduler::Job {
+    public:
+      PadJob(const PadGenerator::KeystreamList &rngs, QByteArray &pad,
+          QVector<QByteArray> &partials) :
+        _rngs(rngs), _pad(pad), _partials(partials.data())
+      {
+      }
+
+      virtual void Process(int start, int end, int range)
+      {
+        QByteArray &out = range == 0 ? _pad : _partials[range - 1];
+        char *data = out.data();
+        for(int idx = start; idx < end; idx++) {
+          _rngs[idx]->XorBlock(data, out.size());
+        }
+      }
+
+    private:
+      const PadGenerator::KeystreamList &_rngs;
+      QByteArray &_pad;
+      QByteArray *_partials;
+  };
+}
+
+  void PadGenerator::XorPads(const KeystreamList &rngs, QByteArray &pad,
+      int threads)
+  {
+    if(rngs.isEmpty() || pad.isEmpty()) {
+      return;
+    }
+
+    if(threads <= 0) {
+      threads = CryptoFactory::GetInstance().GetThreadCount();
+    }
+
+    qint64 total = qint64(rngs.count()) * pad.size();
+    threads = std::min(threads, rngs.count());
+    threads = int(std::min(qint64(threads),
+          std::max(qint64(1), total / MIN_BYTES_PER_THREAD)));
+
+    QVector<QByteArray> partials;
+    for(int idx = 1; idx < threads; idx++) {
+      partials.append(QByteArray(pad.size(), 0));
+    }
+
+    PadJob job(rngs, pad, partials);
+    CryptoFactory::GetInstance().GetScheduler().ParallelFor(rngs.count(), job,
+        Utils::TaskScheduler::Normal, threads);
+
+    if(partials.isEmpty()) {
+      return;
+    }
+
+    QList<QByteArray> sources = partials.toList();
+    Utils::XorKernel::XorMany(pad, sources);
+  }
+}
+}
@@ -0,0 +1,48 @@
+#ifndef DISSENT_CRYPTO_PAD_GENERATOR_H_GUARD
+#define DISSENT_CRYPTO_PAD_GENERATOR_H_GUARD
+
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "KeystreamGenerator.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Generates DC-net pads, the xor of many keystreams, across the threads in
+   * the CryptoFactory thread pool.  Each thread accumulates a contiguous
+   * range of the keystreams into its own buffer, the buffers are then xored
+   * together.  Since xor is commutative and each keystream advances exactly
+   * as it would serially, the output is identical to the serial path.
+   */
+  class PadGenerator {
+    public:
+      typedef QVector<QSharedPointer<KeystreamGenerator> > KeystreamList;
+
+      /**
+       * Xors pad.size() bytes from each keystream into pad
+       * @param rngs the keystreams
+       * @param pad the accumulator
+       * @param threads the amount of threads to use, 0 uses the
+       * CryptoFactory thread count
+       */
+      static void XorPads(const KeystreamList &rngs, QByteArray &pad,
+          int threads = 0);
+
+      /**
+       * Minimum amount of keystream bytes a thread should produce, below this
+       * threading overhead outweighs the gain
+       */
+      static const int MIN_BYTES_PER_THREAD = 64 * 1024;
+
+    private:
+      /**
+       * No instances of this class
+       */
+      PadGenerator() {}
+  };
+}
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "CryptoFactory.hpp"
+#include "SharedSecretCache.hpp"
+
+namespace Dissent {
+namespace Crypto {
+namespace {
+  /**
+   * Computes shared secrets into a preallocated result array
+   */
+  class AgreeJob : public Utils::TaskScheduler::Job {
+    public:
+      AgreeJob(const DiffieHellman &local,
+          const QVector<QByteArray> &remote_pubs, QByteArray *secrets) :
+        _local(local), _remote_pubs(remote_pubs), _secrets(secrets)
+      {
+      }
+
+      virtual void Process(int start, int end, int)
+      {
+        for(int idx = start; idx < end; idx++) {
+          _secrets[idx] = _local.GetSharedSecret(_remote_pubs[idx]);
+        }
+      }
+
+    private:
+      const DiffieHellman &_local;
+      const QVector<QByteArray> &_remote_pubs;
+      QByteArray *_secrets;
+  };
+}
+
+  QReadWriteLock SharedSecretCache::_lock;
+  QHash<QByteArray, SharedSecretCache::SecretTable> SharedSecretCache::_secrets;
+  QList<QByteArray> SharedSecretCache::_local_keys;
+
+  QByteArray SharedSecretCache::GetSharedSecret(const DiffieHellman &local,
+      const QByteArray &remote_pub)
+  {
+    return GetSharedSecrets(local, QVector<QByteArray>(1, remote_pub)).first();
+  }
+
+  QVector<QByteArray> SharedSecretCache::GetSharedSecrets(
+      const DiffieHellman &local, const QVector<QByteArray> &remote_pubs,
+      int threads)
+  {
+    QByteArray local_pub = local.GetPublicComponent();
+    QVector<QByteArray> secrets(remote_pubs.count());
+    QVector<int> missing_idx;
+    QVector<QByteArray> missing;
+
+    {
+      QReadLocker locker(&_lock);
+      SecretTable table = _secrets.value(local_pub);
+      for(int idx = 0; idx < remote_pubs.count(); idx++) {
+        SecretTable::const_iterator it = table.find(remote_pubs[idx]);
+        if(it == table.end()) {
+          missing_idx.append(idx);
+          missing.append(remote_pubs[idx]);
+        } else {
+          secrets[idx] = it.value();
+        }
+      }
+    }
+
+    int count = missing.count();
+    if(count == 0) {
+      return secrets;
+    }
+
+    QVector<QByteArray> computed(count);
+    AgreeJob job(local, missing, computed.data());
+    CryptoFactory::GetInstance().GetScheduler().ParallelFor(count, job,
+        Utils::TaskScheduler::Normal, threads);
+
+    for(int idx = 0; idx < count; idx++) {
+      secrets[missing_idx[idx]] = computed[idx];
+    }
+
+    QWriteLocker locker(&_lock);
+    Insert(local_pub, missing, computed);
+    return secrets;
+  }
+
+  void SharedSecretCache::Insert(const QByteArray &local_pub,
+      const QVector<QByteArray> &remote_pubs,
+      const QVector<QByteArray> &secrets)
+  {
+    _local_keys.removeAll(local_pub);
+    _local_keys.append(local_pub);
+    while(_local_keys.count() > MAX_LOCAL_KEYS) {
+      _secrets.remove(_local_keys.takeFirst());
+    }
+
+    SecretTable &table = _secrets[local_pub];
+    if(table.count() + remote_pubs.count() > MAX_SECRETS) {
+      table.clear();
+    }
+
+    for(int idx = 0; idx < remote_pubs.count(); idx++) {
+      // Failed agreements are not worth remembering
+      if(!secrets[idx].isEmpty()) {
+        table[remote_pubs[idx]] = secrets[idx];
+      }
+    }
+  }
+
+  void SharedSecretCache::Retain(const DiffieHellman &local,
+      const QVector<QByteArray> &remote_pubs)
+  {
+    QByteArray local_pub = local.GetPublicComponent();
+
+    QWriteLocker locker(&_lock);
+    QHash<QByteArray, SecretTable>::iterator it = _secrets.find(local_pub);
+    if(it == _secrets.end()) {
+      return;
+    }
+
+    SecretTable retained;
+    foreach(const QByteArray &remote_pub, remote_pubs) {
+      SecretTable::const_iterator entry = it.value().find(remote_pub);
+      if(entry != it.value().end()) {
+        retained[remote_pub] = entry.value();
+      }
+    }
+    it.value() = retained;
+  }
+
+  void SharedSecretCache::Clear()
+  {
+    QWriteLocker locker(&_lock);
+    _secrets.clear();
+    _local_keys.clear();
+  }
+
+  int SharedSecretCache::Count()
+  {
+    QReadLocker locker(&_lock);
+    int count = 0;
+    foreach(const SecretTable &table, _secrets) {
+      count += table.count();
+    }
+    return count;
+  }
+}
+}
@@ -0,0 +1,98 @@
+#ifndef DISSENT_CRYPTO_SHARED_SECRET_CACHE_H_GUARD
+#define DISSENT_CRYPTO_SHARED_SECRET_CACHE_H_GUARD
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QVector>
+
+#include "DiffieHellman.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Process wide cache of Diffie-Hellman shared secrets, indexed by the
+   * local key's public component and the remote public component.  Long
+   * lived keys agree on the same secret round after round, so rounds fetch
+   * the raw secrets here and only derive their per round seeds themselves.
+   * Entries for a changed key simply stop being used, Retain drops them
+   * along with those of members who have left the group.
+   */
+  class SharedSecretCache {
+    public:
+      /**
+       * Returns the shared secret between local and remote_pub, computing
+       * and caching it if necessary
+       * @param local the local key
+       * @param remote_pub the remote public component
+       */
+      static QByteArray GetSharedSecret(const DiffieHellman &local,
+          const QByteArray &remote_pub);
+
+      /**
+       * Returns the shared secrets between local and each of remote_pubs in
+       * order, computing the missing ones across the CryptoFactory thread
+       * pool
+       * @param local the local key
+       * @param remote_pubs the remote public components
+       * @param threads the amount of threads to use, 0 uses the
+       * CryptoFactory thread count
+       */
+      static QVector<QByteArray> GetSharedSecrets(const DiffieHellman &local,
+          const QVector<QByteArray> &remote_pubs, int threads = 0);
+
+      /**
+       * Drops the secrets of local with any remote not in remote_pubs,
+       * called with the current group whenever it may have changed
+       * @param local the local key
+       * @param remote_pubs the remote public components to keep
+       */
+      static void Retain(const DiffieHellman &local,
+          const QVector<QByteArray> &remote_pubs);
+
+      /**
+       * Drops all cached secrets
+       */
+      static void Clear();
+
+      /**
+       * Returns the amount of cached secrets
+       */
+      static int Count();
+
+      /**
+       * Maximum amount of local keys with cached secrets, the least recently
+       * used is dropped beyond this
+       */
+      static const int MAX_LOCAL_KEYS = 4;
+
+      /**
+       * Maximum amount of secrets cached per local key, the key's secrets
+       * are dropped beyond this
+       */
+      static const int MAX_SECRETS = 4096;
+
+    private:
+      typedef QHash<QByteArray, QByteArray> SecretTable;
+
+      /**
+       * No instances of this class
+       */
+      SharedSecretCache() {}
+
+      /**
+       * Stores computed secrets, the write lock must be held
+       */
+      static void Insert(const QByteArray &local_pub,
+          const QVector<QByteArray> &remote_pubs,
+          const QVector<QByteArray> &secrets);
+
+      static QReadWriteLock _lock;
+      static QHash<QByteArray, SecretTable> _secrets;
+      static QList<QByteArray> _local_keys;
+  };
+}
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include <string.h>
+
+#include "SlotRandomizer.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  SlotRandomizer::SlotRandomizer(Library *lib) :
+    _seed_size(lib->RngOptimalSeedSize()),
+    _seed(_seed_size, 0),
+    _seed_rng(lib->GetRandomNumberGenerator()),
+    _keystream(lib->GetKeystreamGenerator(QByteArray(_seed_size, 0)))
+  {
+  }
+
+  QByteArray SlotRandomizer::Randomize(const QByteArray &msg)
+  {
+    QByteArray randomized;
+    randomized.resize(_seed_size + msg.size());
+    Randomize(msg.constData(), msg.size(), randomized.data());
+    return randomized;
+  }
+
+  void SlotRandomizer::Randomize(const char *msg, int length, char *out)
+  {
+    do {
+      _seed_rng->GenerateBlock(_seed);
+    } while(IsNullSeed(_seed.constData(), _seed_size));
+
+    memcpy(out, _seed.constData(), _seed_size);
+    _keystream->SetKey(_seed);
+    _keystream->XorBlock(out + _seed_size, msg, length);
+  }
+
+  QByteArray SlotRandomizer::Derandomize(const QByteArray &randomized)
+  {
+    if(randomized.size() < _seed_size ||
+        IsNullSeed(randomized.constData(), _seed_size))
+    {
+      return QByteArray();
+    }
+
+    QByteArray msg;
+    msg.resize(randomized.size() - _seed_size);
+    _keystream->SetKey(QByteArray::fromRawData(randomized.constData(),
+          _seed_size));
+    _keystream->XorBlock(msg.data(), randomized.constData() + _seed_size,
+        msg.size());
+    return msg;
+  }
+
+  bool SlotRandomizer::IsNullSeed(const char *seed, int length)
+  {
+    char acc = 0;
+    for(int idx = 0; idx < length; idx++) {
+      acc |= seed[idx];
+    }
+    return acc == 0;
+  }
+}
+}
@@ -0,0 +1,73 @@
+#ifndef DISSENT_CRYPTO_SLOT_RANDOMIZER_H_GUARD
+#define DISSENT_CRYPTO_SLOT_RANDOMIZER_H_GUARD
+
+#include <QByteArray>
+#include <QScopedPointer>
+
+#include "Utils/Random.hpp"
+
+#include "KeystreamGenerator.hpp"
+#include "Library.hpp"
+
+namespace Dissent {
+namespace Crypto {
+  /**
+   * Randomizes DC-net slot contents by prepending a fresh seed and xoring
+   * the message with the keystream keyed by that seed.  A seed of all zeroes
+   * marks an empty slot.  A single keystream context is rekeyed for every
+   * message and the keystream is applied directly into the output buffer,
+   * so encoding or decoding a slot performs exactly one allocation: the
+   * result.  Instances are not thread safe, use one per thread.
+   */
+  class SlotRandomizer {
+    public:
+      /**
+       * Constructor
+       * @param lib the library providing the seed source and keystream
+       */
+      explicit SlotRandomizer(Library *lib);
+
+      /**
+       * Returns the amount of seed bytes prepended to each message
+       */
+      inline int GetSeedSize() const { return _seed_size; }
+
+      /**
+       * Randomizes a message and prepends the seed
+       * @param msg the message to randomize
+       */
+      QByteArray Randomize(const QByteArray &msg);
+
+      /**
+       * Randomizes length bytes of msg into out, which must hold
+       * GetSeedSize() + length bytes
+       * @param msg the message to randomize
+       * @param length the length of the message
+       * @param out the output buffer
+       */
+      void Randomize(const char *msg, int length, char *out);
+
+      /**
+       * Derandomizes a message with the seed prepended, returns an empty
+       * message for the null seed or a message shorter than the seed
+       * @param randomized the randomized text
+       */
+      QByteArray Derandomize(const QByteArray &randomized);
+
+      /**
+       * Returns true if the seed is the null seed, used to mark empty slots
+       * @param seed the start of the seed
+       * @param length the size of the seed
+       */
+      static bool IsNullSeed(const char *seed, int length);
+
+    private:
+      int _seed_size;
+      QByteArray _seed;
+      QScopedPointer<Utils::Random> _seed_rng;
+      QScopedPointer<KeystreamGenerator> _keystream;
+  };
+}
+}
+
+#endif
@@ -1,51 +1,198 @@
+#include <algorithm>
+#include <QSet>
+
+#include "CryptoFactory.hpp"
 #include "ThreadedOnionEncryptor.hpp"
-#include <qcoreapplication.h>
-#include <QtConcurrentMap>
 
 namespace Dissent {
 namespace Crypto {
   namespace {
     /**
-     * Provides a method object decrypting a single QByteArray, useful for QtConcurrent
+     * Removes a layer from each ciphertext, optionally digesting each
+     * ciphertext along the way
      */
-    struct Decryptor {
-      Decryptor(const QSharedPointer<AsymmetricKey> &key) : _key(key) {}
+    class DecryptJob : public Utils::TaskScheduler::Job {
+      public:
+        DecryptJob(const QSharedPointer<AsymmetricKey> &key,
+            const QVector<QByteArray> &ciphertext,
+            QVector<QByteArray> &cleartext, QVector<QByteArray> *digests = 0) :
+          _key(key), _ciphertext(ciphertext), _cleartext(cleartext),
+          _digests(digests)
+        {
+        }
 
-      typedef QByteArray result_type;
+        virtual void Process(int start, int end, int)
+        {
+          for(int idx = start; idx < end; idx++) {
+            _cleartext[idx] = _key->Decrypt(_ciphertext[idx]);
+            if(_digests) {
+              (*_digests)[idx] = CryptoFactory::GetInstance().GetThreadHash().
+                ComputeHash(_ciphertext[idx]);
+            }
+          }
+        }
 
-      QByteArray operator()(const QByteArray &ciphertext) const
-      {
-        return _key->Decrypt(ciphertext);
-      }
+      private:
+        const QSharedPointer<AsymmetricKey> &_key;
+        const QVector<QByteArray> &_ciphertext;
+        QVector<QByteArray> &_cleartext;
+        QVector<QByteArray> *_digests;
+    };
+
+    /**
+     * Checks that each message of each layer decrypts into the layer below,
+     * index idx covers message idx % msgs of layer idx / msgs
+     */
+    class VerifyJob : public Utils::TaskScheduler::Job {
+      public:
+        VerifyJob(const QVector<QSharedPointer<AsymmetricKey> > &keys,
+            const QVector<QVector<QByteArray> > &onion,
+            const QVector<QSet<QByteArray> > &cleartexts,
+            int msgs, QVector<char> &results) :
+          _keys(keys), _onion(onion), _cleartexts(cleartexts),
+          _msgs(msgs), _results(results)
+        {
+        }
 
-      const QSharedPointer<AsymmetricKey> _key;
+        virtual void Process(int start, int end, int)
+        {
+          for(int idx = start; idx < end; idx++) {
+            int layer = idx / _msgs;
+            int msg = idx % _msgs;
+            if(msg >= _onion[layer + 1].count()) {
+              continue;
+            }
+
+            QByteArray clr = _keys[layer]->Decrypt(_onion[layer + 1][msg]);
+            _results[idx] = _cleartexts[layer].contains(clr) ? 1 : 0;
+          }
+        }
+
+      private:
+        const QVector<QSharedPointer<AsymmetricKey> > &_keys;
+        const QVector<QVector<QByteArray> > &_onion;
+        const QVector<QSet<QByteArray> > &_cleartexts;
+        int _msgs;
+        QVector<char> &_results;
     };
+
+    /**
+     * Returns false and optionally the indexes of any cleartext that failed
+     * to decrypt
+     */
+    bool FindBad(const QVector<QByteArray> &cleartext, QVector<int> *bad)
+    {
+      bool res = true;
+      for(int idx = 0; idx < cleartext.count(); idx++) {
+        if(!cleartext[idx].isEmpty()) {
+          continue;
+        }
+
+        res = false;
+        if(bad) {
+          bad->append(idx);
+        }
+      }
+      return res;
+    }
+
+    QSet<QByteArray> ToSet(const QVector<QByteArray> &data)
+    {
+      QSet<QByteArray> set;
+      set.reserve(data.count());
+      foreach(const QByteArray &entry, data) {
+        set.insert(entry);
+      }
+      return set;
+    }
+  }
+
+  ThreadedOnionEncryptor::ThreadedOnionEncryptor(int threads) :
+    _scheduler(new Utils::TaskScheduler(threads))
+  {
+  }
+
+  ThreadedOnionEncryptor::~ThreadedOnionEncryptor()
+  {
   }
 
   bool ThreadedOnionEncryptor::Decrypt(const QSharedPointer<AsymmetricKey> &key,
       const QVector<QByteArray> &ciphertext, QVector<QByteArray> &cleartext,
       QVector<int> *bad) const
   {
-    QFuture<QByteArray> result = QtConcurrent::mapped(ciphertext.begin(),
-        ciphertext.end(), Decryptor(key));
-    cleartext.clear();
-    result.waitForFinished();
+    QVector<QByteArray> output(ciphertext.count());
+    DecryptJob job(key, ciphertext, output);
+    _scheduler->ParallelFor(ciphertext.count(), job);
+    cleartext = output;
+    return FindBad(cleartext, bad);
+  }
 
-    bool res = true;
-    int idx = -1;
-    foreach(const QByteArray &data, result) {
-      idx++;
-      cleartext.append(data);
+  bool ThreadedOnionEncryptor::DecryptWithDigests(
+      const QSharedPointer<AsymmetricKey> &key,
+      const QVector<QByteArray> &ciphertext, QVector<QByteArray> &cleartext,
+      QVector<QByteArray> &digests, QVector<int> *bad) const
+  {
+    QVector<QByteArray> output(ciphertext.count());
+    QVector<QByteArray> output_digests(ciphertext.count());
+    DecryptJob job(key, ciphertext, output, &output_digests);
+    _scheduler->ParallelFor(ciphertext.count(), job);
+    cleartext = output;
+    digests = output_digests;
+    return FindBad(cleartext, bad);
+  }
+
+  bool ThreadedOnionEncryptor::VerifyOne(const QSharedPointer<AsymmetricKey> &key,
+      const QVector<QByteArray> &cleartext,
+      const QVector<QByteArray> &ciphertext) const
+  {
+    QVector<QSharedPointer<AsymmetricKey> > keys(1, key);
+    QVector<QVector<QByteArray> > onion;
+    onion << cleartext << ciphertext;
+    QBitArray bad;
+    return VerifyAll(keys, onion, bad);
+  }
+
+  bool ThreadedOnionEncryptor::VerifyAll(
+      const QVector<QSharedPointer<AsymmetricKey> > &keys,
+      const QVector<QVector<QByteArray> > &onion, QBitArray &bad) const
+  {
+    if(keys.count() != onion.count() - 1) {
+      qWarning() << "Incorrect key to onion layers ratio: " << keys.count() <<
+        ":" << onion.count();
+      return false;
+    }
 
-      if(!data.isEmpty()) {
+    if(keys.count() != bad.count()) {
+      bad = QBitArray(keys.count(), false);
+    }
+
+    int msgs = 0;
+    QVector<QSet<QByteArray> > cleartexts;
+    for(int idx = 0; idx < keys.count(); idx++) {
+      msgs = std::max(msgs, onion[idx + 1].count());
+      cleartexts.append(ToSet(onion[idx]));
+    }
+
+    if(msgs == 0) {
+      return true;
+    }
+
+    // Every (layer, message) pair is independent, so flatten them into one
+    // job rather than waiting on each layer in turn
+    QVector<char> results(keys.count() * msgs, 1);
+    VerifyJob job(keys, onion, cleartexts, msgs, results);
+    _scheduler->ParallelFor(results.count(), job,
+        Utils::TaskScheduler::Critical);
+
+    bool res = true;
+    for(int idx = 0; idx < results.count(); idx++) {
+      if(results[idx]) {
         continue;
       }
-
+      bad[idx / msgs] = true;
       res = false;
-      if(bad) {
-        bad->append(idx);
-      }
     }
+
     return res;
   }
 }
@@ -3,18 +3,36 @@
 
 #include <QByteArray>
 #include <QDebug>
+#include <QScopedPointer>
 #include <QVector>
 
+#include "Utils/TaskScheduler.hpp"
+
 #include "AsymmetricKey.hpp"
 #include "OnionEncryptor.hpp"
 
 namespace Dissent {
 namespace Crypto {
   /**
-   * Provides a multithreaded tool around onion encrypting messages
+   * Provides a multithreaded tool around onion encrypting messages.  Work
+   * runs on a scheduler owned by the encryptor, so a large shuffle does not
+   * starve the CryptoFactory's scheduler, and verification is queued ahead
+   * of decryption.
    */
   class ThreadedOnionEncryptor : public QObject, public OnionEncryptor {
     public:
+      /**
+       * Constructor
+       * @param threads the size of the encryptor's scheduler, 0 uses one per
+       * core
+       */
+      explicit ThreadedOnionEncryptor(int threads = 0);
+
+      /**
+       * Destructor
+       */
+      virtual ~ThreadedOnionEncryptor();
+
       /**
        * Using the key it removes a layer of encryption from ciphertexts,
        * returns true if everything parses fine
@@ -28,9 +46,62 @@ namespace Crypto {
           QVector<QByteArray> &cleartext, QVector<int> *bad) const;
 
       /**
-       * Destructor
+       * Decrypts and digests each ciphertext in parallel
+       * @param key the private key used for decryption
+       * @param ciphertext the set of data to decrypt
+       * @param cleartext the resulting cleartext
+       * @param digests the resulting digest of each ciphertext
+       * @param bad optionally returns index of malformed messages
        */
-      virtual ~ThreadedOnionEncryptor() {}
+      virtual bool DecryptWithDigests(const QSharedPointer<AsymmetricKey> &key,
+          const QVector<QByteArray> &ciphertext,
+          QVector<QByteArray> &cleartext, QVector<QByteArray> &digests,
+          QVector<int> *bad) const;
+
+      /**
+       * Verifies that the ciphertext and cleartext match, decrypting the
+       * ciphertexts in parallel
+       * @param key the key used for verification
+       * @param cleartext the unencrypted data
+       * @param ciphertext the encrypted data
+       */
+      virtual bool VerifyOne(const QSharedPointer<AsymmetricKey> &key,
+          const QVector<QByteArray> &cleartext,
+          const QVector<QByteArray> &ciphertext) const;
+
+      /**
+       * Verifies every layer of the onion, spreading each message of each
+       * layer across the pool rather than one layer at a time
+       * @param keys keys used for verification
+       * @param onion the set of onion data with the 0th index being the least
+       * encrypted and the maximum index being the most encrypted
+       * @param bad indexes are set if the key had issue decrypting
+       */
+      virtual bool VerifyAll(const QVector<QSharedPointer<AsymmetricKey> > &keys,
+          const QVector<QVector<QByteArray> > &onion,
+          QBitArray &bad) const;
+
+      /**
+       * Resizes the encryptor's scheduler
+       * @param threads the amount of threads, 0 uses one per core
+       */
+      inline void SetThreadCount(int threads)
+      {
+        _scheduler->SetThreadCount(threads);
+      }
+
+      /**
+       * Returns the size of the encryptor's scheduler
+       */
+      inline int GetThreadCount() const { return _scheduler->GetThreadCount(); }
+
+      /**
+       * Returns the timing of the encryptor's tasks
+       */
+      inline Utils::TaskStats GetStats() const { return _scheduler->GetStats(); }
+
+    private:
+      QScopedPointer<Utils::TaskScheduler> _scheduler;
   };
 }
 }
@@ -17,6 +17,7 @@
 #include "Anonymity/ShuffleBlamer.hpp"
 #include "Anonymity/ShuffleRound.hpp"
 #include "Anonymity/ShuffleRoundBlame.hpp"
+#include "Anonymity/SubmissionDeadline.hpp"
 #include "Anonymity/Tolerant/Accusation.hpp"
 #include "Anonymity/Tolerant/AlibiData.hpp"
 #include "Anonymity/Tolerant/BlameMatrix.hpp"
@@ -53,30 +54,48 @@
 #include "Connections/RelayEdgeListener.hpp"
 
 #include "Crypto/AsymmetricKey.hpp"
+#include "Crypto/BatchVerifier.hpp"
+#include "Crypto/CppBlake2bHash.hpp"
 #include "Crypto/CppDiffieHellman.hpp"
 #include "Crypto/CppDsaLibrary.hpp"
 #include "Crypto/CppDsaPrivateKey.hpp"
 #include "Crypto/CppDsaPublicKey.hpp"
+#include "Crypto/CppEcDiffieHellman.hpp"
+#include "Crypto/CppEcGroup.hpp"
+#include "Crypto/CppEcLibrary.hpp"
+#include "Crypto/CppEcPrivateKey.hpp"
+#include "Crypto/CppEcPublicKey.hpp"
+#include "Crypto/CppFixedBaseCache.hpp"
+#include "Crypto/CppFixedBaseTable.hpp"
 #include "Crypto/CppHash.hpp"
+#include "Crypto/CppInteger.hpp"
 #include "Crypto/CppIntegerData.hpp"
+#include "Crypto/CppKeystreamGenerator.hpp"
 #include "Crypto/CppLibrary.hpp"
 #include "Crypto/CppPrivateKey.hpp"
 #include "Crypto/CppPublicKey.hpp"
 #include "Crypto/CppRandom.hpp"
+#include "Crypto/CppSha256Hash.hpp"
 #include "Crypto/CryptoFactory.hpp"
 #include "Crypto/DiffieHellman.hpp"
 #include "Crypto/CppHash.hpp"
 #include "Crypto/Hash.hpp"
 #include "Crypto/Integer.hpp"
 #include "Crypto/IntegerData.hpp"
+#include "Crypto/KeystreamGenerator.hpp"
 #include "Crypto/Library.hpp"
 #include "Crypto/NullDiffieHellman.hpp"
 #include "Crypto/NullHash.hpp"
+#include "Crypto/NullKeystreamGenerator.hpp"
 #include "Crypto/NullLibrary.hpp"
 #include "Crypto/NullPrivateKey.hpp"
 #include "Crypto/NullPublicKey.hpp"
 #include "Crypto/OnionEncryptor.hpp"
+#include "Crypto/PadCache.hpp"
+#include "Crypto/PadGenerator.hpp"
 #include "Crypto/Serialization.hpp"
+#include "Crypto/SharedSecretCache.hpp"
+#include "Crypto/SlotRandomizer.hpp"
 #include "Crypto/ThreadedOnionEncryptor.hpp"
 
 #include "Identity/Authentication/IAuthenticate.hpp"
@@ -154,6 +173,7 @@
 #include "Utils/Sleeper.hpp"
 #include "Utils/StartStop.hpp"
 #include "Utils/StartStopSlots.hpp"
+#include "Utils/TaskScheduler.hpp"
 #include "Utils/Time.hpp"
 #include "Utils/Timer.hpp"
 #include "Utils/TimerCallback.hpp"
@@ -161,6 +181,8 @@
 #include "Utils/Triggerable.hpp"
 #include "Utils/Triple.hpp"
 #include "Utils/Utils.hpp"
+#include "Utils/XorKernel.hpp"
+#include "Utils/ZeroRunLength.hpp"
 
 #include "Web/HttpRequest.hpp"
 #include "Web/HttpResponse.hpp"
@@ -3,6 +3,7 @@
 
 #include <QPair>
 #include <QVariant>
+#include <QVector>
 
 #include "Connections/Id.hpp"
 
@@ -37,6 +38,25 @@ namespace Authentication {
        */
       virtual QPair<bool, PublicIdentity> VerifyResponse(const Id &member,
           const QVariant &data) = 0;
+
+      /**
+       * Verifies a batch of responses, implementations may check them
+       * concurrently.  The outcome must match calling VerifyResponse on each
+       * response in order.
+       * @param members the authenticating members
+       * @param data the response data, one per member
+       * @returns for each response, true and a valid members identity or
+       * false and nothing
+       */
+      virtual QVector<QPair<bool, PublicIdentity> > VerifyResponses(
+          const QVector<Id> &members, const QVector<QVariant> &data)
+      {
+        QVector<QPair<bool, PublicIdentity> > results;
+        for(int idx = 0; idx < members.count(); idx++) {
+          results.append(VerifyResponse(members[idx], data[idx]));
+        }
+        return results;
+      }
   };
 }
 }
@@ -1,74 +1,163 @@
+#include "Crypto/CryptoFactory.hpp"
+
 #include "LRSAuthenticator.hpp"
 #include "LRVerifier.hpp"
 
 namespace Dissent {
 namespace Identity {
 namespace Authentication {
+namespace {
+  /**
+   * Verifies ring signatures into a preallocated result array
+   */
+  class VerifyJob : public Utils::TaskScheduler::Job {
+    public:
+      VerifyJob(LRVerifier &verifier, const QByteArray &message,
+          const QVector<QVariant> &signatures, bool *results) :
+        _verifier(verifier), _message(message), _signatures(signatures),
+        _results(results)
+      {
+      }
+
+      virtual void Process(int start, int end, int)
+      {
+        for(int idx = start; idx < end; idx++) {
+          _results[idx] = _verifier.LRVerify(_message, _signatures[idx]);
+        }
+      }
+
+    private:
+      LRVerifier &_verifier;
+      const QByteArray &_message;
+      const QVector<QVariant> &_signatures;
+      bool *_results;
+  };
+}
 
   LRSAuthenticator::LRSAuthenticator(
     const QVector<QSharedPointer<PublicIdentity> > &public_ident):
     _public_ident(public_ident)
   {
+    //Get Asymmetric keys from public_idents.
+    for(QVector<QSharedPointer<PublicIdentity> >::const_iterator itr =
+        _public_ident.begin(); itr != _public_ident.end(); ++itr)
+    {
+      _public_ident_asymm.push_back((*itr)->GetVerificationKey());
+    }
   }
 
   QPair<bool, PublicIdentity> LRSAuthenticator::VerifyResponse(
     const Connections::Id &member, const QVariant &data)
   {
-    QByteArray _context_tag(10,'a');
-    QByteArray _message(10, 'b');
+    return VerifyResponses(QVector<Id>(1, member),
+        QVector<QVariant>(1, data))[0];
+  }
 
+  bool LRSAuthenticator::ParseResponse(const Id &member, const QVariant &data,
+      PublicIdentity &ident, QByteArray &ident_byte, QVariant &signature,
+      QByteArray &tag) const
+  {
     QVariantList response = data.toList();
     if(response.count() != 2)
     {
       qDebug() << "Received invalid response";
-      return QPair<bool, PublicIdentity> (false, PublicIdentity());
+      return false;
     }
 
-    QByteArray ident_byte = response[0].toByteArray();
+    ident_byte = response[0].toByteArray();
     QDataStream stream(ident_byte);
-    PublicIdentity ident;
     stream >> ident;
 
     if(ident.GetId() != member)
     {
       qDebug() << "Invalid Id";
-      return QPair<bool, PublicIdentity> (false, PublicIdentity());
+      return false;
     }
 
-    QVariant signature = response[1];
-
-    //store tags and corresponding public_ident
-    QList<QVariant> in;
-    in = signature.toList();
-    QByteArray tag = in[2].toByteArray();
+    signature = response[1];
 
-    //Check for multiple authentication.
-    //FIXME: Policy decision - what to do if a client tries to authenticate twice.
-    if(_tag_public_idents.contains(tag))
+    QList<QVariant> in = signature.toList();
+    if(in.count() != 3)
     {
-      qDebug() << "Client already authenticated.";
-      return QPair<bool, PublicIdentity>(false, PublicIdentity());
+      qDebug() << "Received invalid signature";
+      return false;
     }
 
-    _tag_public_idents[tag] = ident_byte;
+    tag = in[2].toByteArray();
+    return true;
+  }
+
+  QVector<QPair<bool, PublicIdentity> > LRSAuthenticator::VerifyResponses(
+      const QVector<Id> &members, const QVector<QVariant> &data)
+  {
+    QByteArray _context_tag(10,'a');
+    QByteArray _message(10, 'b');
 
-    QVector<QSharedPointer<AsymmetricKey> > _public_ident_asymm;
+    int count = members.count();
+    QVector<QPair<bool, PublicIdentity> > results(count,
+        QPair<bool, PublicIdentity>(false, PublicIdentity()));
 
-    //Get Asymmetric keys from public_idents.
-    for(QVector<QSharedPointer<PublicIdentity> >::const_iterator itr =
-        _public_ident.begin(); itr != _public_ident.end(); ++itr)
-    {
-      _public_ident_asymm.push_back((*itr)->GetVerificationKey());
+    // Parse and screen against already accepted tags serially.  Responses
+    // sharing a tag within the batch are all verified, a forged copy of a
+    // tag must not shadow the genuine response that follows it.
+    QVector<int> pending;
+    QVector<PublicIdentity> idents(count);
+    QVector<QByteArray> ident_bytes(count);
+    QVector<QByteArray> tags(count);
+    QVector<QVariant> signatures;
+
+    for(int idx = 0; idx < count; idx++) {
+      QVariant signature;
+      if(!ParseResponse(members[idx], data[idx], idents[idx],
+            ident_bytes[idx], signature, tags[idx]))
+      {
+        continue;
+      }
+
+      //Check for multiple authentication.
+      //FIXME: Policy decision - what to do if a client tries to authenticate twice.
+      if(_tag_public_idents.contains(tags[idx]))
+      {
+        qDebug() << "Client already authenticated.";
+        continue;
+      }
+
+      pending.append(idx);
+      signatures.append(signature);
+    }
+
+    int verify_count = pending.count();
+    if(verify_count == 0) {
+      return results;
     }
 
     LRVerifier autho(_public_ident_asymm, _context_tag);
-    if(!autho.LRVerify(_message, signature))
-    {
-      qDebug() << "Invalid signature";
-      return QPair<bool, PublicIdentity>(false, PublicIdentity());
+    QVector<bool> valid(verify_count, false);
+    VerifyJob job(autho, _message, signatures, valid.data());
+    Crypto::CryptoFactory::GetInstance().GetScheduler().ParallelFor(
+        verify_count, job, Utils::TaskScheduler::Critical);
+
+    // Accept in arrival order, the first valid response per tag wins
+    for(int pdx = 0; pdx < verify_count; pdx++) {
+      int idx = pending[pdx];
+      if(!valid[pdx])
+      {
+        qDebug() << "Invalid signature";
+        continue;
+      }
+
+      if(_tag_public_idents.contains(tags[idx]))
+      {
+        qDebug() << "Client already authenticated.";
+        continue;
+      }
+
+      //store tags and corresponding public_ident
+      _tag_public_idents[tags[idx]] = ident_bytes[idx];
+      results[idx] = QPair<bool, PublicIdentity>(true, idents[idx]);
     }
 
-    return (QPair<bool, PublicIdentity>(true, ident));
+    return results;
   }
 
 }
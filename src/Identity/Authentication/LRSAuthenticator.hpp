@@ -3,6 +3,7 @@
 
 #include <QHash>
 #include <QVariant>
+#include <QVector>
 #include <QPair>
 #include "Crypto/Integer.hpp"
 #include "Crypto/CppHash.hpp"
@@ -42,8 +43,33 @@ namespace Authentication {
       virtual QPair<bool, PublicIdentity> VerifyResponse(const Id &member,
         const QVariant &data);
 
+      /**
+       * Verifies a batch of signatures, the ring signatures are checked
+       * concurrently on the CryptoFactory thread pool.  A linkage tag is
+       * only accepted once, the first valid response carrying it wins.
+       * @param members the authenticating members
+       * @param data the response data, one per member
+       */
+      virtual QVector<QPair<bool, PublicIdentity> > VerifyResponses(
+          const QVector<Id> &members, const QVector<QVariant> &data);
+
      private:
+      /**
+       * Parses a response, returns false if it is malformed or does not
+       * belong to member
+       * @param member the authenticating member
+       * @param data the response data
+       * @param ident returns the identity of the member
+       * @param ident_byte returns the serialized identity
+       * @param signature returns the ring signature
+       * @param tag returns the linkage tag
+       */
+      bool ParseResponse(const Id &member, const QVariant &data,
+          PublicIdentity &ident, QByteArray &ident_byte, QVariant &signature,
+          QByteArray &tag) const;
+
        const QVector<QSharedPointer<PublicIdentity> > _public_ident;
+       QVector<QSharedPointer<AsymmetricKey> > _public_ident_asymm;
        QHash<QByteArray, QByteArray> _tag_public_idents;
    };
 }
@@ -19,18 +19,24 @@ namespace Authentication {
     _g = priv_key->GetGenerator();
     _p = priv_key->GetModulus();
     _q = priv_key->GetSubgroup();
+    // Shared by every signer and verifier of the group
+    _g_table = Crypto::CppFixedBaseCache::Register(
+        Crypto::CppIntegerData::GetInteger(_g),
+        Crypto::CppIntegerData::GetInteger(_p));
 
     //get the self_identity -- by comparing the "matching" public_key in the list.
     qint32 counter = 0;
     _self_identity = -1;
 
     QSharedPointer<CppDsaPrivateKey> t2 = _priv_ident.dynamicCast<CppDsaPrivateKey>();
+    Integer self_public = CppInteger(_g).Pow(CppInteger(t2->GetPrivateExponent()),
+        CppInteger(_p), _g_table.data()).ToInteger();
 
     for(QVector<QSharedPointer<AsymmetricKey> >::const_iterator itr =
         _public_ident.begin(); itr != _public_ident.end(); ++itr, ++counter)
     {
       QSharedPointer<CppDsaPublicKey> t1 = (*itr).dynamicCast<CppDsaPublicKey>();
-      if(_g.Pow(t2->GetPrivateExponent(), _p) == t1->GetPublicElement())
+      if(self_public == t1->GetPublicElement())
       {
         _self_identity = counter;
         break;
@@ -43,6 +49,12 @@ namespace Authentication {
    _public_ident_byte = GetPublicIdentByteArray();
    _num_members = _public_ident.count();
 
+   _public_elements.reserve(_num_members);
+   for(int i = 0; i < _public_ident.count(); i++) {
+     _public_elements.append(CppInteger(
+           _public_ident[i].dynamicCast<CppDsaPublicKey>()->GetPublicElement()));
+   }
+
  }
 
   const QByteArray LRSigner::GetPublicIdentByteArray()
@@ -65,9 +77,13 @@ namespace Authentication {
     QByteArray input_hash_byte = _public_ident_byte + _context_tag;
 
     //Calculate hash = H(public_keys) and map it to an element in the group.
+    //The ring loop runs on value-type integers to avoid an allocation per
+    //operation.
+    const CppInteger g(_g), p(_p), q(_q);
+
     Crypto::CppHash hash_object;
     Integer group_hash = (Integer(hash_object.ComputeHash(input_hash_byte)))%_q;
-    group_hash = _g.Pow(group_hash, _p);
+    group_hash = g.Pow(CppInteger(group_hash), p, _g_table.data()).ToInteger();
 
     QSharedPointer<Crypto::CppDsaPrivateKey> priv_key =
       _priv_ident.dynamicCast<CppDsaPrivateKey>();
@@ -86,37 +102,41 @@ namespace Authentication {
     Integer u(random_byte_array);
     u = u%_q;
 
-    QVector<Integer> ci(_num_members), si(_num_members);
+    const CppInteger cpp_group_hash(group_hash);
+    QVector<CppInteger> ci(_num_members), si(_num_members);
+    const CppInteger linkage_int(linkage_tag);
 
     input_hash_byte = _public_ident_byte + linkage_tag + message +
-      _g.Pow(u, _p).GetByteArray() + group_hash.Pow(u, _p).GetByteArray();
+      g.Pow(CppInteger(u), p, _g_table.data()).GetByteArray() +
+      group_hash.Pow(u, _p).GetByteArray();
 
     hash_object.Restart();
-    Integer b = Integer(hash_object.ComputeHash(input_hash_byte));
+    ci[(_self_identity + 1) % _num_members] =
+      CppInteger(hash_object.ComputeHash(input_hash_byte));
 
-    ci[(_self_identity + 1) % _num_members] = b;
+    //The hash input shares this prefix for every member
+    const QByteArray prefix = _public_ident_byte + linkage_tag + message;
 
     for(int i = (_self_identity + 1) % _num_members; i != _self_identity;
          i = (i + 1)%_num_members)
     {
       rng->GenerateBlock(random_byte_array);
 
-      si[i] = (Integer(random_byte_array)%_q);
-
-      QSharedPointer<Crypto::CppDsaPublicKey> publ_k =
-        _public_ident[i].dynamicCast<CppDsaPublicKey>();
-
-      input_hash_byte = _public_ident_byte + linkage_tag + message +
-        ((_g.Pow(si[i], _p) * publ_k->GetPublicElement().Pow(ci[i], _p)) % _p).GetByteArray()
-        + ((group_hash.Pow(si[i], _p) * Integer(linkage_tag).Pow(ci[i], _p)) % _p).GetByteArray();
+      CppInteger(random_byte_array).swap(si[i]);
+      si[i] %= q;
 
       //compute hash
-      hash_object.Restart();
-      ci[(i+1)%_num_members] = Integer(hash_object.ComputeHash(input_hash_byte));
+      hash_object.Update(prefix);
+      hash_object.Update(g.CascadePow(si[i], _public_elements[i], ci[i],
+            p).GetByteArray());
+      hash_object.Update(cpp_group_hash.CascadePow(si[i], linkage_int, ci[i],
+            p).GetByteArray());
+      CppInteger(hash_object.ComputeHash()).swap(ci[(i+1)%_num_members]);
     }
 
-    si[_self_identity] = ((u % _q) -
-      ((priv_key->GetPrivateExponent())*(ci[_self_identity]) % _q)) % _q;
+    Integer self_ci = ci[_self_identity].ToInteger();
+    si[_self_identity] = CppInteger(((u % _q) -
+      ((priv_key->GetPrivateExponent())*(self_ci) % _q)) % _q);
 
     QList<QVariant> temp, signature;
     signature.append(QVariant(ci[0].GetByteArray()));
@@ -8,6 +8,8 @@
 #include "Crypto/CppHash.hpp"
 #include "Crypto/CppDsaPrivateKey.hpp"
 #include "Crypto/CppDsaPublicKey.hpp"
+#include "Crypto/CppFixedBaseCache.hpp"
+#include "Crypto/CppInteger.hpp"
 #include "Crypto/AsymmetricKey.hpp"
 #include "Connections/Id.hpp"
 #include "Identity/PublicIdentity.hpp"
@@ -30,6 +32,8 @@ namespace Identity {
       typedef Crypto::CppDsaPublicKey CppDsaPublicKey;
       typedef Crypto::CppDsaPrivateKey CppDsaPrivateKey;
       typedef Crypto::AsymmetricKey AsymmetricKey;
+      typedef Crypto::CppInteger CppInteger;
+      typedef Crypto::CppFixedBaseTable CppFixedBaseTable;
 
       virtual ~LRSigner() {}
       LRSigner() {}
@@ -62,7 +66,8 @@ namespace Identity {
       QByteArray _public_ident_byte;
       const QSharedPointer<AsymmetricKey> _priv_ident;
       const QByteArray _context_tag;
-
+      QVector<CppInteger> _public_elements;
+      QSharedPointer<const CppFixedBaseTable> _g_table;
   };
  }
 }
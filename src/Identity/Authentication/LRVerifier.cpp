@@ -16,9 +16,19 @@ namespace Authentication {
      _g = publ_k->GetGenerator();
      _p = publ_k->GetModulus();
      _q = publ_k->GetSubgroup();
+     // Shared by every signer and verifier of the group
+     _g_table = Crypto::CppFixedBaseCache::Register(
+         Crypto::CppIntegerData::GetInteger(_g),
+         Crypto::CppIntegerData::GetInteger(_p));
 
      _public_ident_byte = GetPublicIdentByteArray();
      _num_members = _public_ident.count();
+
+     _public_elements.reserve(_num_members);
+     for(int i = 0; i < _public_ident.count(); i++) {
+       _public_elements.append(CppInteger(
+             _public_ident[i].dynamicCast<CppDsaPublicKey>()->GetPublicElement()));
+     }
   }
 
   const QByteArray LRVerifier::GetPublicIdentByteArray()
@@ -60,46 +70,52 @@ namespace Authentication {
         return invalid;
     }
 
-    _num_members = _public_ident.count();
-
     //prepare input byte array - public_identities.
     QByteArray input_hash_byte = _public_ident_byte + _context_tag;
 
     //Calculate hash = H(public_keys) and map it to an element in the group.
+    //The ring loop runs on value-type integers to avoid an allocation per
+    //operation.
     Dissent::Crypto::CppHash hash_object;
-    Integer group_hash = (Integer(hash_object.ComputeHash(input_hash_byte))%_q);
-    group_hash = _g.Pow(group_hash, _p);
+    const CppInteger g(_g), p(_p);
+    CppInteger group_hash(hash_object.ComputeHash(input_hash_byte));
+    group_hash %= CppInteger(_q);
+    group_hash = g.Pow(group_hash, p, _g_table.data());
 
-    Integer zi, zi_dash;
-    Integer ci = Integer(in[0].toByteArray());
+    CppInteger zi, zi_dash;
+    CppInteger ci(in[0].toByteArray());
     QList<QVariant> si_variant = in[1].toList();
-    QVector<Integer> si;
-    Integer linkage_tag = Integer(in[2].toByteArray());
-
-    for(int i = 0; i < _num_members; i++)
+    if(si_variant.count() != int(_num_members))
     {
-      si.push_back(Integer(si_variant.at(i).toByteArray()));
+      qWarning() << "Invalid challenge from client: wrong ring size";
+      return invalid;
     }
 
+    QVector<CppInteger> si(_num_members);
+    const CppInteger linkage_tag(in[2].toByteArray());
+
     for(int i = 0; i < _num_members; i++)
     {
-      QSharedPointer<Crypto::CppDsaPublicKey> publ_k =
-        _public_ident[i].dynamicCast<CppDsaPublicKey>();
-
-      zi = (_g.Pow(si[i], _p) * (publ_k->GetPublicElement().Pow(ci, _p))) % _p;
+      CppInteger(si_variant.at(i).toByteArray()).swap(si[i]);
+    }
 
-      zi_dash = ((group_hash.Pow(si[i], _p))*(linkage_tag.Pow(ci, _p))) % _p;
+    //The hash input shares this prefix for every member
+    const QByteArray prefix = _public_ident_byte +
+      linkage_tag.GetByteArray() + message;
 
-      //prepare input hash string
-      input_hash_byte = _public_ident_byte + linkage_tag.GetByteArray() +
-        message + zi.GetByteArray() + zi_dash.GetByteArray();
+    for(int i = 0; i < _num_members; i++)
+    {
+      g.CascadePow(si[i], _public_elements[i], ci, p).swap(zi);
+      group_hash.CascadePow(si[i], linkage_tag, ci, p).swap(zi_dash);
 
       //compute hash
-      hash_object.Restart();
-      ci = Integer(hash_object.ComputeHash(input_hash_byte));
+      hash_object.Update(prefix);
+      hash_object.Update(zi.GetByteArray());
+      hash_object.Update(zi_dash.GetByteArray());
+      CppInteger(hash_object.ComputeHash()).swap(ci);
     }
 
-    return (Integer(in[0].toByteArray()) == ci);
+    return (CppInteger(in[0].toByteArray()) == ci);
   }
 
 }
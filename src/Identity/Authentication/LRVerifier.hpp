@@ -8,6 +8,8 @@
 #include "Crypto/CppHash.hpp"
 #include "Crypto/CppDsaPrivateKey.hpp"
 #include "Crypto/CppDsaPublicKey.hpp"
+#include "Crypto/CppFixedBaseCache.hpp"
+#include "Crypto/CppInteger.hpp"
 #include "Crypto/AsymmetricKey.hpp"
 #include "Connections/Id.hpp"
 #include "Identity/PublicIdentity.hpp"
@@ -30,6 +32,8 @@ namespace Identity {
       typedef Crypto::CppDsaPublicKey CppDsaPublicKey;
       typedef Crypto::CppDsaPrivateKey CppDsaPrivateKey;
       typedef Crypto::AsymmetricKey AsymmetricKey;
+      typedef Crypto::CppInteger CppInteger;
+      typedef Crypto::CppFixedBaseTable CppFixedBaseTable;
 
       virtual ~LRVerifier() {}
       LRVerifier() {}
@@ -45,7 +49,8 @@ namespace Identity {
         const QByteArray &context_tag);
 
       /**
-       * Verify signature of the client.
+       * Verify signature of the client, does not modify the verifier so it
+       * may be called concurrently from multiple threads.
        */
       virtual bool LRVerify(const QByteArray &message, const QVariant &signature);
 
@@ -60,6 +65,8 @@ namespace Identity {
       const QVector<QSharedPointer<AsymmetricKey> > _public_ident;
       QByteArray _public_ident_byte;
       const QByteArray _context_tag;
+      QVector<CppInteger> _public_elements;
+      QSharedPointer<const CppFixedBaseTable> _g_table;
   };
  }
 }
@@ -1,4 +1,8 @@
+#include <QElapsedTimer>
+
 #include "DissentTest.hpp"
+#include "Identity/Authentication/LRSigner.hpp"
+#include "Identity/Authentication/LRVerifier.hpp"
 
 namespace Dissent {
 namespace Tests {
@@ -195,5 +199,216 @@ namespace Tests {
 
 
   }
+
+  /**
+   * Creates identities whose keys share a single DSA group
+   * @param count the amount of identities
+   * @param public_idents returns the public identities
+   * @param priv_idents returns the private identities
+   */
+  void CreateLRSIdentities(int count,
+      QVector<QSharedPointer<PublicIdentity> > &public_idents,
+      QVector<QSharedPointer<PrivateIdentity> > &priv_idents)
+  {
+    QScopedPointer<CppDsaPrivateKey> base_key(new CppDsaPrivateKey());
+    for(int idx = 0; idx < count; idx++) {
+      QSharedPointer<AsymmetricKey> key(new CppDsaPrivateKey(
+            base_key->GetModulus(), base_key->GetSubgroup(),
+            base_key->GetGenerator()));
+      Id id;
+      priv_idents.append(QSharedPointer<PrivateIdentity>(new PrivateIdentity(
+              id, key, QSharedPointer<DiffieHellman>(), true)));
+      public_idents.append(QSharedPointer<PublicIdentity>(new PublicIdentity(
+              id, QSharedPointer<AsymmetricKey>(key->GetPublicKey()),
+              QByteArray(), true)));
+    }
+  }
+
+  TEST(Authenticate, LRSBatch)
+  {
+    QVector<QSharedPointer<PublicIdentity> > public_idents;
+    QVector<QSharedPointer<PrivateIdentity> > priv_idents;
+    CreateLRSIdentities(8, public_idents, priv_idents);
+
+    LRSAuthenticator auth_leader(public_idents);
+
+    QVector<Id> members;
+    QVector<QVariant> responses;
+    for(int idx = 0; idx < 6; idx++) {
+      LRSAuthenticate auth_client(public_idents, priv_idents[idx]);
+      members.append(priv_idents[idx]->GetLocalId());
+      responses.append(auth_client.ProcessChallenge(QVariant()).second);
+    }
+
+    // A replayed response and a response claiming the wrong member
+    members.append(members[0]);
+    responses.append(responses[0]);
+    members.append(priv_idents[7]->GetLocalId());
+    responses.append(responses[1]);
+
+    int original = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    QVector<QPair<bool, PublicIdentity> > results =
+      auth_leader.VerifyResponses(members, responses);
+    CryptoFactory::GetInstance().SetThreadCount(original);
+
+    ASSERT_EQ(members.count(), results.count());
+    for(int idx = 0; idx < 6; idx++) {
+      EXPECT_TRUE(results[idx].first);
+      EXPECT_EQ(members[idx], results[idx].second.GetId());
+    }
+    EXPECT_FALSE(results[6].first);
+    EXPECT_FALSE(results[7].first);
+
+    // Already authenticated members are rejected on later batches too
+    EXPECT_FALSE(auth_leader.VerifyResponse(members[2], responses[2]).first);
+  }
+
+  TEST(Authenticate, LRSBatchForgedTag)
+  {
+    QVector<QSharedPointer<PublicIdentity> > public_idents;
+    QVector<QSharedPointer<PrivateIdentity> > priv_idents;
+    CreateLRSIdentities(4, public_idents, priv_idents);
+
+    LRSAuthenticator auth_leader(public_idents);
+
+    QVector<QVariant> genuine;
+    for(int idx = 0; idx < 2; idx++) {
+      LRSAuthenticate auth_client(public_idents, priv_idents[idx]);
+      genuine.append(auth_client.ProcessChallenge(QVariant()).second);
+    }
+
+    // Copy member 0's tag into a response whose signature does not verify
+    QVariantList forged = genuine[0].toList();
+    QVariantList signature = forged[1].toList();
+    signature[0] = genuine[1].toList()[1].toList()[0];
+    forged[1] = signature;
+
+    QVector<Id> members;
+    QVector<QVariant> responses;
+    members.append(priv_idents[0]->GetLocalId());
+    responses.append(forged);
+    members.append(priv_idents[0]->GetLocalId());
+    responses.append(genuine[0]);
+    members.append(priv_idents[0]->GetLocalId());
+    responses.append(genuine[0]);
+
+    int original = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    QVector<QPair<bool, PublicIdentity> > results =
+      auth_leader.VerifyResponses(members, responses);
+    CryptoFactory::GetInstance().SetThreadCount(original);
+
+    ASSERT_EQ(members.count(), results.count());
+    EXPECT_FALSE(results[0].first);
+    EXPECT_TRUE(results[1].first);
+    EXPECT_EQ(members[1], results[1].second.GetId());
+    EXPECT_FALSE(results[2].first);
+  }
+
+  TEST(Authenticate, LRSCascade)
+  {
+    QScopedPointer<CppDsaPrivateKey> base_key(new CppDsaPrivateKey());
+    QVector<QSharedPointer<AsymmetricKey> > private_keys;
+    QVector<QSharedPointer<AsymmetricKey> > public_keys;
+    for(int idx = 0; idx < 4; idx++) {
+      QSharedPointer<AsymmetricKey> key(new CppDsaPrivateKey(
+            base_key->GetModulus(), base_key->GetSubgroup(),
+            base_key->GetGenerator()));
+      private_keys.append(key);
+      public_keys.append(QSharedPointer<AsymmetricKey>(key->GetPublicKey()));
+    }
+
+    Integer g = base_key->GetGenerator();
+    Integer p = base_key->GetModulus();
+    Integer q = base_key->GetSubgroup();
+    Integer y = public_keys[1].dynamicCast<CppDsaPublicKey>()->GetPublicElement();
+    for(int idx = 0; idx < 5; idx++) {
+      Integer s = Integer::GetRandomInteger(0, q);
+      Integer c = Integer::GetRandomInteger(0, q);
+      EXPECT_EQ((g.Pow(s, p) * y.Pow(c, p)) % p, g.CascadePow(s, y, c, p));
+    }
+
+    QByteArray message(64, 'm');
+    LRSigner signer(public_keys, private_keys[2], QByteArray("context"));
+    LRVerifier verifier(public_keys, QByteArray("context"));
+    QVariant signature = signer.LRSign(message);
+    EXPECT_TRUE(verifier.LRVerify(message, signature));
+    EXPECT_FALSE(verifier.LRVerify(QByteArray(64, 'n'), signature));
+  }
+
+  TEST(Authenticate, DISABLED_LRSCascadeBenchmark)
+  {
+    // A few distinct keys sharing a group, repeated to fill larger rings
+    QScopedPointer<CppDsaPrivateKey> base_key(new CppDsaPrivateKey());
+    QVector<QSharedPointer<AsymmetricKey> > private_keys;
+    QVector<QSharedPointer<AsymmetricKey> > public_keys;
+    for(int idx = 0; idx < 10; idx++) {
+      QSharedPointer<AsymmetricKey> key(new CppDsaPrivateKey(
+            base_key->GetModulus(), base_key->GetSubgroup(),
+            base_key->GetGenerator()));
+      private_keys.append(key);
+      public_keys.append(QSharedPointer<AsymmetricKey>(key->GetPublicKey()));
+    }
+
+    Integer g = base_key->GetGenerator();
+    Integer p = base_key->GetModulus();
+    Integer q = base_key->GetSubgroup();
+    Integer y = public_keys[1].dynamicCast<CppDsaPublicKey>()->GetPublicElement();
+
+    // Per member cost of g^s * y^c, separately and as a cascade
+    const int samples = 100;
+    QVector<Integer> exps;
+    for(int idx = 0; idx < 2 * samples; idx++) {
+      exps.append(Integer::GetRandomInteger(0, q));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for(int idx = 0; idx < samples; idx++) {
+      Integer value = (g.Pow(exps[2 * idx], p) * y.Pow(exps[2 * idx + 1], p)) % p;
+      Q_UNUSED(value);
+    }
+    qint64 separate = std::max(timer.nsecsElapsed(), qint64(1));
+
+    timer.restart();
+    for(int idx = 0; idx < samples; idx++) {
+      Integer value = g.CascadePow(exps[2 * idx], y, exps[2 * idx + 1], p);
+      Q_UNUSED(value);
+    }
+    qint64 cascade = std::max(timer.nsecsElapsed(), qint64(1));
+
+    EXPECT_EQ((g.Pow(exps[0], p) * y.Pow(exps[1], p)) % p,
+        g.CascadePow(exps[0], y, exps[1], p));
+
+    qDebug() << "!BENCHMARK!" << "LRS products | modulus bits:" <<
+      p.GetBitCount() << "| separate usecs:" << separate / 1000.0 / samples <<
+      "| cascade usecs:" << cascade / 1000.0 / samples <<
+      "| speedup:" << double(separate) / cascade;
+
+    int sizes[] = {10, 100, 1000, 5000};
+    QByteArray message(64, 'm');
+    for(uint sdx = 0; sdx < sizeof(sizes) / sizeof(int); sdx++) {
+      QVector<QSharedPointer<AsymmetricKey> > ring;
+      for(int idx = 0; idx < sizes[sdx]; idx++) {
+        ring.append(public_keys[idx % public_keys.count()]);
+      }
+
+      LRSigner signer(ring, private_keys[0], QByteArray("context"));
+      LRVerifier verifier(ring, QByteArray("context"));
+
+      timer.restart();
+      QVariant signature = signer.LRSign(message);
+      qint64 sign = timer.nsecsElapsed();
+
+      timer.restart();
+      EXPECT_TRUE(verifier.LRVerify(message, signature));
+      qint64 verify = timer.nsecsElapsed();
+
+      qDebug() << "!BENCHMARK!" << "LRS | ring:" << sizes[sdx] <<
+        "| sign msecs:" << sign / 1000000.0 <<
+        "| verify msecs:" << verify / 1000000.0;
+    }
+  }
 }
 }
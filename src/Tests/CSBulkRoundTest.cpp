@@ -11,6 +11,16 @@ namespace Tests {
         Group::ManagedSubgroup);
   }
 
+  TEST(CSBulkRound, BasicEc)
+  {
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    CryptoFactory::LibraryName cname = cf.GetLibraryName();
+    cf.SetLibrary(CryptoFactory::CryptoPPEc);
+    RoundTest_Basic(SessionCreator(TCreateRound<CSBulkRound>),
+        Group::ManagedSubgroup);
+    cf.SetLibrary(cname);
+  }
+
   TEST(CSBulkRound, MultiRoundManaged)
   {
     RoundTest_MultiRound(SessionCreator(TCreateRound<CSBulkRound>),
@@ -35,12 +45,37 @@ namespace Tests {
         Group::ManagedSubgroup);
   }
 
+  TEST(CSBulkRound, BasicPipelined)
+  {
+    CSBulkRound::SetPhasesInFlight(3);
+    RoundTest_Basic(SessionCreator(TCreateRound<CSBulkRound>),
+        Group::ManagedSubgroup);
+    CSBulkRound::SetPhasesInFlight(1);
+  }
+
+  TEST(CSBulkRound, MultiRoundPipelined)
+  {
+    CSBulkRound::SetPhasesInFlight(2);
+    RoundTest_MultiRound(SessionCreator(TCreateRound<CSBulkRound>),
+        Group::ManagedSubgroup);
+    CSBulkRound::SetPhasesInFlight(1);
+  }
+
   TEST(CSBulkRound, BasicRoundManagedNeffKey)
   {
     RoundTest_Basic(SessionCreator(TCreateBulkRound<CSBulkRound, NeffKeyShuffle>),
         Group::ManagedSubgroup);
   }
 
+  TEST(CSBulkRound, BasicRoundManagedNeffKeyEc)
+  {
+    bool use_ec = NeffKeyShuffle::GetEllipticCurve();
+    NeffKeyShuffle::SetEllipticCurve(true);
+    RoundTest_Basic(SessionCreator(TCreateBulkRound<CSBulkRound, NeffKeyShuffle>),
+        Group::ManagedSubgroup);
+    NeffKeyShuffle::SetEllipticCurve(use_ec);
+  }
+
   TEST(CSBulkRound, MultiRoundManagedNeffKey)
   {
     RoundTest_MultiRound(SessionCreator(TCreateBulkRound<CSBulkRound, NeffKeyShuffle>),
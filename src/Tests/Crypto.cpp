@@ -1,3 +1,7 @@
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QThreadPool>
+
 #include "DissentTest.hpp"
 
 namespace Dissent {
@@ -272,6 +276,121 @@ namespace Tests {
     }
   }
 
+  void BatchVerifierTest(Library *lib)
+  {
+    QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+    BatchVerifier verifier;
+    QList<bool> expected;
+
+    for(int idx = 0; idx < 25; idx++) {
+      QSharedPointer<AsymmetricKey> key(lib->CreatePrivateKey());
+      QSharedPointer<AsymmetricKey> pkey(key->GetPublicKey());
+      QByteArray data(100 + idx, 0);
+      rng->GenerateBlock(data);
+      QByteArray sig = key->Sign(data);
+
+      bool valid = (idx % 4) != 1;
+      if(!valid) {
+        data[0] = data[0] ^ 0x01;
+      }
+      expected.append(valid);
+      EXPECT_EQ(idx, verifier.Add(pkey, data, sig));
+    }
+
+    EXPECT_EQ(25, verifier.Count());
+    QList<int> thread_counts;
+    thread_counts << 1 << 2 << 7 << 50;
+    foreach(int threads, thread_counts) {
+      QVector<bool> results = verifier.Verify(threads);
+      EXPECT_EQ(expected, results.toList());
+      EXPECT_FALSE(verifier.VerifyAll(threads));
+    }
+
+    verifier.Clear();
+    EXPECT_EQ(0, verifier.Count());
+    EXPECT_TRUE(verifier.VerifyAll());
+  }
+
+  TEST(Crypto, CppBatchVerifier)
+  {
+    int threads = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    QScopedPointer<Library> lib(new CppLibrary());
+    BatchVerifierTest(lib.data());
+    CryptoFactory::GetInstance().SetThreadCount(threads);
+  }
+
+  TEST(Crypto, NullBatchVerifier)
+  {
+    QScopedPointer<Library> lib(new NullLibrary());
+    BatchVerifierTest(lib.data());
+  }
+
+  void SharedSecretCacheTest(Library *lib)
+  {
+    SharedSecretCache::Clear();
+    QScopedPointer<DiffieHellman> local(lib->CreateDiffieHellman());
+    QScopedPointer<DiffieHellman> other_local(lib->CreateDiffieHellman());
+
+    QList<QSharedPointer<DiffieHellman> > remotes;
+    QVector<QByteArray> remote_pubs;
+    for(int idx = 0; idx < 10; idx++) {
+      remotes.append(QSharedPointer<DiffieHellman>(lib->CreateDiffieHellman()));
+      remote_pubs.append(remotes.last()->GetPublicComponent());
+    }
+
+    QList<int> thread_counts;
+    thread_counts << 1 << 3 << 50;
+    foreach(int threads, thread_counts) {
+      SharedSecretCache::Clear();
+      QVector<QByteArray> secrets =
+        SharedSecretCache::GetSharedSecrets(*local, remote_pubs, threads);
+      ASSERT_EQ(remote_pubs.count(), secrets.count());
+      for(int idx = 0; idx < remotes.count(); idx++) {
+        EXPECT_EQ(local->GetSharedSecret(remote_pubs[idx]), secrets[idx]);
+        EXPECT_EQ(remotes[idx]->GetSharedSecret(local->GetPublicComponent()),
+            secrets[idx]);
+      }
+      EXPECT_EQ(remote_pubs.count(), SharedSecretCache::Count());
+    }
+
+    // Cached and freshly computed secrets are mixed in order
+    QVector<QByteArray> subset;
+    subset << remote_pubs[3] << other_local->GetPublicComponent() <<
+      remote_pubs[0];
+    QVector<QByteArray> secrets = SharedSecretCache::GetSharedSecrets(*local,
+        subset);
+    for(int idx = 0; idx < subset.count(); idx++) {
+      EXPECT_EQ(local->GetSharedSecret(subset[idx]), secrets[idx]);
+    }
+    EXPECT_EQ(remote_pubs.count() + 1, SharedSecretCache::Count());
+
+    EXPECT_EQ(SharedSecretCache::GetSharedSecret(*other_local,
+          local->GetPublicComponent()), secrets[1]);
+    EXPECT_EQ(remote_pubs.count() + 2, SharedSecretCache::Count());
+
+    // A smaller group only drops the secrets of the given local key
+    SharedSecretCache::Retain(*local, subset);
+    EXPECT_EQ(subset.count() + 1, SharedSecretCache::Count());
+    EXPECT_EQ(local->GetSharedSecret(remote_pubs[5]),
+        SharedSecretCache::GetSharedSecret(*local, remote_pubs[5]));
+
+    SharedSecretCache::Clear();
+    EXPECT_EQ(0, SharedSecretCache::Count());
+  }
+
+  TEST(Crypto, CppSharedSecretCache)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    SharedSecretCacheTest(lib.data());
+  }
+
+  TEST(Crypto, CppEcSharedSecretCache)
+  {
+    QScopedPointer<Library> lib(new CppEcLibrary());
+    SharedSecretCacheTest(lib.data());
+  }
+
   TEST(Crypto, CppAsymmetricKey)
   {
     QScopedPointer<Library> lib(new CppLibrary());
@@ -282,6 +401,53 @@ namespace Tests {
         std::max(AsymmetricKey::DefaultKeySize, lib->MinimumKeySize()));
   }
 
+  class SharedKeyUser : public QRunnable {
+    public:
+      SharedKeyUser(const AsymmetricKey *key, const AsymmetricKey *pkey,
+          int seed, bool *result) :
+        _key(key), _pkey(pkey), _seed(seed), _result(result)
+      {
+      }
+
+      virtual void run()
+      {
+        *_result = true;
+        for(int idx = 0; idx < 20; idx++) {
+          QByteArray data(64 + idx, char(_seed));
+          QByteArray sig = _key->Sign(data);
+          *_result &= _pkey->Verify(data, sig);
+          data[0] = data[0] ^ 0x01;
+          *_result &= !_pkey->Verify(data, sig);
+          *_result &= (_key->Decrypt(_pkey->Encrypt(data)) == data);
+        }
+      }
+
+    private:
+      const AsymmetricKey *_key;
+      const AsymmetricKey *_pkey;
+      int _seed;
+      bool *_result;
+  };
+
+  TEST(Crypto, CppKeySharedAcrossThreads)
+  {
+    QScopedPointer<AsymmetricKey> key(new CppPrivateKey());
+    QScopedPointer<AsymmetricKey> pkey(key->GetPublicKey());
+
+    const int threads = 4;
+    bool results[threads];
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for(int idx = 0; idx < threads; idx++) {
+      pool.start(new SharedKeyUser(key.data(), pkey.data(), idx, &results[idx]));
+    }
+    pool.waitForDone();
+
+    for(int idx = 0; idx < threads; idx++) {
+      EXPECT_TRUE(results[idx]);
+    }
+  }
+
   TEST(Crypto, CppKeySerialization)
   {
     CryptoFactory &cf = CryptoFactory::GetInstance();
@@ -310,6 +476,42 @@ namespace Tests {
     cf.SetLibrary(cname);
   }
 
+  TEST(Crypto, CppEcAsymmetricKey)
+  {
+    QScopedPointer<Library> lib(new CppEcLibrary());
+    AsymmetricKeyTest(lib.data());
+    KeyGenerationFromIdTest(lib.data());
+
+    QScopedPointer<AsymmetricKey> key(lib->CreatePrivateKey());
+    EXPECT_EQ(key->GetKeySize(), lib->MinimumKeySize());
+    EXPECT_EQ(key->GetSignatureLength(), key->Sign(QByteArray(10, 0)).size());
+
+    // Keys from another library never load
+    QScopedPointer<Library> dsa_lib(new CppDsaLibrary());
+    QScopedPointer<AsymmetricKey> dsa_key(dsa_lib->CreatePrivateKey());
+    QScopedPointer<AsymmetricKey> dsa_pkey(dsa_key->GetPublicKey());
+    QScopedPointer<AsymmetricKey> bad_key(
+        lib->LoadPrivateKeyFromByteArray(dsa_key->GetByteArray()));
+    EXPECT_FALSE(bad_key->IsValid());
+    bad_key.reset(lib->LoadPublicKeyFromByteArray(dsa_pkey->GetByteArray()));
+    EXPECT_FALSE(bad_key->IsValid());
+  }
+
+  TEST(Crypto, CppEcKeySerialization)
+  {
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    CryptoFactory::LibraryName cname = cf.GetLibraryName();
+    cf.SetLibrary(CryptoFactory::CryptoPPEc);
+    AsymmetricKeySerialization();
+    cf.SetLibrary(cname);
+  }
+
+  TEST(Crypto, CppEcBatchVerifier)
+  {
+    QScopedPointer<Library> lib(new CppEcLibrary());
+    BatchVerifierTest(lib.data());
+  }
+
   TEST(Crypto, NullAsymmetricKey)
   {
     QScopedPointer<Library> lib(new NullLibrary());
@@ -349,6 +551,144 @@ namespace Tests {
     ZeroKnowledgeTest(lib.data(), false);
   }
 
+  TEST(Crypto, CppEcDiffieHellman)
+  {
+    QScopedPointer<Library> lib(new CppEcLibrary());
+    DiffieHellmanTest(lib.data());
+
+    QScopedPointer<DiffieHellman> dh(lib->CreateDiffieHellman());
+    EXPECT_TRUE(dh->GetSharedSecret(QByteArray()).isEmpty());
+    QByteArray bad_pub = dh->GetPublicComponent();
+    bad_pub[0] = 0x05;
+    EXPECT_TRUE(dh->GetSharedSecret(bad_pub).isEmpty());
+  }
+
+  TEST(Crypto, CppEcZeroKnowledgeDhTest)
+  {
+    QScopedPointer<Library> lib(new CppEcLibrary());
+    ZeroKnowledgeTest(lib.data(), true);
+  }
+
+  TEST(Crypto, CppEcGroup)
+  {
+    Integer generator = CppEcGroup::GetGenerator();
+    EXPECT_TRUE(CppEcGroup::IsElement(generator));
+    EXPECT_FALSE(CppEcGroup::IsElement(Integer(0)));
+    EXPECT_FALSE(CppEcGroup::IsElement(CppEcGroup::GetOrder()));
+
+    Integer a = CppEcGroup::GetRandomExponent();
+    Integer b = CppEcGroup::GetRandomExponent();
+    Integer ga = CppEcGroup::Multiply(generator, a);
+    Integer gb = CppEcGroup::Multiply(generator, b);
+    EXPECT_TRUE(CppEcGroup::IsElement(ga));
+    EXPECT_NE(ga, gb);
+    EXPECT_EQ(CppEcGroup::Multiply(ga, b), CppEcGroup::Multiply(gb, a));
+    EXPECT_EQ(CppEcGroup::Multiply(ga, b), CppEcGroup::Multiply(generator,
+          (a * b) % CppEcGroup::GetOrder()));
+    EXPECT_EQ(CppEcGroup::Multiply(Integer(0), a), Integer(0));
+
+    // Keys on a rebased generator, as produced by the Neff key shuffle
+    CppEcPrivateKey base_key;
+    EXPECT_EQ(base_key.GetGenerator(), generator);
+    EXPECT_EQ(CppEcGroup::Multiply(generator, base_key.GetPrivateExponent()),
+        base_key.GetPublicElement());
+
+    CppEcPrivateKey key(ga, base_key.GetPrivateExponent());
+    ASSERT_TRUE(key.IsValid());
+    EXPECT_EQ(key.GetGenerator(), ga);
+    EXPECT_EQ(key.GetPublicElement(),
+        CppEcGroup::Multiply(base_key.GetPublicElement(), a));
+
+    CppEcPublicKey pkey(ga, key.GetPublicElement());
+    ASSERT_TRUE(pkey.IsValid());
+    EXPECT_TRUE(pkey.VerifyKey(key));
+    QScopedPointer<AsymmetricKey> base_pkey(base_key.GetPublicKey());
+    EXPECT_FALSE(base_pkey->VerifyKey(key));
+
+    QByteArray data(1024, 0);
+    CppRandom().GenerateBlock(data);
+    QByteArray sig = key.Sign(data);
+    EXPECT_EQ(sig.size(), pkey.GetSignatureLength());
+    EXPECT_TRUE(pkey.Verify(data, sig));
+    EXPECT_FALSE(base_key.Verify(data, sig));
+
+    CppEcPublicKey loaded(pkey.GetByteArray());
+    ASSERT_TRUE(loaded.IsValid());
+    EXPECT_EQ(loaded.GetGenerator(), ga);
+    EXPECT_TRUE(loaded.Verify(data, sig));
+
+    CppEcPrivateKey random_key(gb);
+    ASSERT_TRUE(random_key.IsValid());
+    EXPECT_EQ(random_key.GetGenerator(), gb);
+
+    EXPECT_FALSE(CppEcPublicKey(Integer(0), ga).IsValid());
+    EXPECT_FALSE(CppEcPrivateKey(CppEcGroup::GetOrder()).IsValid());
+  }
+
+  TEST(Crypto, DISABLED_LibraryBenchmark)
+  {
+    const int members = 32;
+    const int messages = 50;
+    QByteArray data(1024, 0);
+
+    QList<CryptoFactory::LibraryName> names;
+    names << CryptoFactory::CryptoPP << CryptoFactory::CryptoPPDsa <<
+      CryptoFactory::CryptoPPEc;
+    QStringList labels;
+    labels << "rsa" << "dsa" << "ec";
+
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    CryptoFactory::LibraryName cname = cf.GetLibraryName();
+
+    for(int idx = 0; idx < names.count(); idx++) {
+      cf.SetLibrary(names[idx]);
+      Library *lib = cf.GetLibrary();
+
+      QElapsedTimer timer;
+      timer.start();
+      QScopedPointer<AsymmetricKey> key(lib->CreatePrivateKey());
+      qint64 key_setup = timer.nsecsElapsed();
+      QScopedPointer<AsymmetricKey> pkey(key->GetPublicKey());
+
+      // As in CSBulkRound::SetupRngSeeds, one agreement per member
+      QList<QSharedPointer<DiffieHellman> > remotes;
+      for(int member = 0; member < members; member++) {
+        remotes.append(QSharedPointer<DiffieHellman>(lib->CreateDiffieHellman()));
+      }
+
+      timer.restart();
+      QScopedPointer<DiffieHellman> dh(lib->CreateDiffieHellman());
+      foreach(const QSharedPointer<DiffieHellman> &remote, remotes) {
+        EXPECT_FALSE(dh->GetSharedSecret(remote->GetPublicComponent()).isEmpty());
+      }
+      qint64 dh_setup = timer.nsecsElapsed();
+
+      QByteArray sig;
+      timer.restart();
+      for(int count = 0; count < messages; count++) {
+        sig = key->Sign(data);
+      }
+      qint64 sign = timer.nsecsElapsed();
+
+      timer.restart();
+      for(int count = 0; count < messages; count++) {
+        EXPECT_TRUE(pkey->Verify(data, sig));
+      }
+      qint64 verify = timer.nsecsElapsed();
+
+      qDebug() << "!BENCHMARK!" << "Library" << labels[idx] <<
+        "| key gen msecs:" << key_setup / 1000000.0 <<
+        "| dh setup msecs (" << members << "members):" << dh_setup / 1000000.0 <<
+        "| sign usecs:" << sign / 1000.0 / messages <<
+        "| verify usecs:" << verify / 1000.0 / messages <<
+        "| signature bytes:" << sig.size() <<
+        "| public key bytes:" << pkey->GetByteArray().size() <<
+        "| dh public bytes:" << dh->GetPublicComponent().size();
+    }
+
+    cf.SetLibrary(cname);
+  }
+
   TEST(Crypto, CppDsaNeff)
   {
     int keys = 50;
@@ -447,5 +787,68 @@ namespace Tests {
       EXPECT_TRUE(key3.Validate(rng, idx));
 
   }
+
+  TEST(Crypto, DISABLED_CppDsaSignBenchmark)
+  {
+    const int messages = 100;
+    QByteArray data(1024, 'd');
+
+    CppDsaPrivateKey key;
+    ASSERT_TRUE(key.IsValid());
+    QScopedPointer<AsymmetricKey> pkey(key.GetPublicKey());
+
+    // The same key without the fixed-base table
+    typedef CryptoPP::GDSA<CryptoPP::SHA256> Dsa;
+    Dsa::PrivateKey plain_key;
+    plain_key.Initialize(CppIntegerData::GetInteger(key.GetModulus()),
+        CppIntegerData::GetInteger(key.GetSubgroup()),
+        CppIntegerData::GetInteger(key.GetGenerator()),
+        CppIntegerData::GetInteger(key.GetPrivateExponent()));
+    Dsa::PublicKey plain_pkey;
+    plain_key.MakePublicKey(plain_pkey);
+    Dsa::Signer signer(plain_key);
+    Dsa::Verifier verifier(plain_pkey);
+    CryptoPP::AutoSeededX917RNG<CryptoPP::DES_EDE3> rng;
+
+    QElapsedTimer timer;
+    QByteArray sig;
+    timer.start();
+    for(int count = 0; count < messages; count++) {
+      sig = key.Sign(data);
+    }
+    qint64 sign = std::max(timer.nsecsElapsed(), qint64(1));
+
+    timer.restart();
+    for(int count = 0; count < messages; count++) {
+      EXPECT_TRUE(pkey->Verify(data, sig));
+    }
+    qint64 verify = std::max(timer.nsecsElapsed(), qint64(1));
+
+    QByteArray plain_sig(signer.MaxSignatureLength(), 0);
+    timer.restart();
+    for(int count = 0; count < messages; count++) {
+      signer.SignMessage(rng, reinterpret_cast<const byte *>(data.data()),
+          data.size(), reinterpret_cast<byte *>(plain_sig.data()));
+    }
+    qint64 plain_sign = timer.nsecsElapsed();
+
+    timer.restart();
+    for(int count = 0; count < messages; count++) {
+      EXPECT_TRUE(verifier.VerifyMessage(
+            reinterpret_cast<const byte *>(data.data()), data.size(),
+            reinterpret_cast<const byte *>(sig.data()), sig.size()));
+    }
+    qint64 plain_verify = timer.nsecsElapsed();
+    EXPECT_TRUE(pkey->Verify(data, plain_sig));
+
+    qDebug() << "!BENCHMARK!" << "DsaSign | modulus bits:" <<
+      key.GetKeySize() << "| plain sign usecs:" <<
+      plain_sign / 1000.0 / messages << "| table sign usecs:" <<
+      sign / 1000.0 / messages << "| sign speedup:" <<
+      double(plain_sign) / sign << "| plain verify usecs:" <<
+      plain_verify / 1000.0 / messages << "| table verify usecs:" <<
+      verify / 1000.0 / messages << "| verify speedup:" <<
+      double(plain_verify) / verify;
+  }
 }
 }
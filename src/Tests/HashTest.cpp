@@ -1,3 +1,5 @@
+#include <QElapsedTimer>
+
 #include "DissentTest.hpp"
 
 namespace Dissent {
@@ -35,5 +37,97 @@ namespace Tests {
     QScopedPointer<Hash> hashalgo(new CppHash());
     HashTest(hashalgo.data());
   }
+
+  TEST(Crypto, CppSha256HashTest)
+  {
+    QScopedPointer<Hash> hashalgo(new CppSha256Hash());
+    HashTest(hashalgo.data());
+    EXPECT_EQ(32, hashalgo->GetDigestSize());
+    EXPECT_EQ(QByteArray::fromHex("ba7816bf8f01cfea414140de5dae2223"
+          "b00361a396177a9cb410ff61f20015ad"),
+        hashalgo->ComputeHash(QByteArray("abc")));
+  }
+
+  TEST(Crypto, CppBlake2bHashTest)
+  {
+    QScopedPointer<Hash> hashalgo(new CppBlake2bHash());
+    HashTest(hashalgo.data());
+    EXPECT_EQ(64, hashalgo->GetDigestSize());
+    EXPECT_EQ(QByteArray::fromHex("ba80a53f981c4d0d6a2797b69f12f6e9"
+          "4c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc95"
+          "18d38aa8dbf1925ab92386edd4009923"),
+        hashalgo->ComputeHash(QByteArray("abc")));
+  }
+
+  TEST(Crypto, HashSelection)
+  {
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    CryptoFactory::LibraryName cname = cf.GetLibraryName();
+    CryptoFactory::HashName hname = cf.GetHashName();
+    cf.SetLibrary(CryptoFactory::CryptoPP);
+
+    QList<CryptoFactory::HashName> names;
+    names << CryptoFactory::Sha1 << CryptoFactory::Sha256 <<
+      CryptoFactory::Blake2b;
+    QList<int> sizes;
+    sizes << 20 << 32 << 64;
+
+    for(int idx = 0; idx < names.count(); idx++) {
+      cf.SetHash(names[idx]);
+      EXPECT_EQ(names[idx], cf.GetHashName());
+
+      QScopedPointer<Hash> hashalgo(cf.GetLibrary()->GetHashAlgorithm());
+      EXPECT_EQ(sizes[idx], hashalgo->GetDigestSize());
+
+      // The thread hash is reused and always starts out restarted
+      Hash &thread_hash = cf.GetThreadHash();
+      EXPECT_EQ(sizes[idx], thread_hash.GetDigestSize());
+      thread_hash.Update(QByteArray("left over"));
+      EXPECT_EQ(&thread_hash, &cf.GetThreadHash());
+      EXPECT_EQ(hashalgo->ComputeHash(QByteArray("abc")),
+          cf.GetThreadHash().ComputeHash(QByteArray("abc")));
+    }
+
+    cf.SetLibrary(CryptoFactory::Null);
+    EXPECT_TRUE(dynamic_cast<NullHash *>(&cf.GetThreadHash()) != 0);
+
+    cf.SetHash(hname);
+    cf.SetLibrary(cname);
+  }
+
+  TEST(Crypto, DISABLED_HashBenchmark)
+  {
+    const int iterations = 20;
+    QList<int> sizes;
+    sizes << 1024 << 64 * 1024 << 1024 * 1024;
+
+    QList<QSharedPointer<Hash> > hashes;
+    hashes << QSharedPointer<Hash>(new CppHash()) <<
+      QSharedPointer<Hash>(new CppSha256Hash()) <<
+      QSharedPointer<Hash>(new CppBlake2bHash());
+    QStringList labels;
+    labels << "sha1" << "sha256" << "blake2b";
+
+    CppRandom rand;
+    QElapsedTimer timer;
+
+    foreach(int size, sizes) {
+      // Ciphertext sized inputs, as hashed into each server commit
+      QByteArray ciphertext(size, 0);
+      rand.GenerateBlock(ciphertext);
+
+      for(int idx = 0; idx < hashes.count(); idx++) {
+        timer.start();
+        for(int count = 0; count < iterations; count++) {
+          hashes[idx]->ComputeHash(ciphertext);
+        }
+        qint64 elapsed = timer.nsecsElapsed() + 1;
+
+        qDebug() << "!BENCHMARK!" << "Hash" << labels[idx] << "| bytes:" <<
+          size << "| MB/s:" << (double(size) * iterations / 1048576.0) /
+          (elapsed / 1000000000.0);
+      }
+    }
+  }
 }
 }
@@ -1,3 +1,5 @@
+#include <QElapsedTimer>
+
 #include "DissentTest.hpp"
 
 namespace Dissent {
@@ -134,5 +136,245 @@ namespace Tests {
     test = 0x7f8f8f8f;
     EXPECT_EQ(0x7f8f8f8f, test.GetInt32());
   }
+
+  TEST(Integer, FixedBaseTable)
+  {
+    CryptoPP::Integer modulus = CppDiffieHellman::GetPInt();
+    CryptoPP::Integer generator = CppDiffieHellman::GetGInt();
+    CppFixedBaseTable table(generator, modulus);
+
+    EXPECT_EQ(CryptoPP::Integer::One(),
+        table.Exponentiate(CryptoPP::Integer::Zero()));
+    EXPECT_EQ(generator, table.Exponentiate(CryptoPP::Integer::One()));
+
+    for(int idx = 0; idx < 20; idx++) {
+      Integer exp = Integer::GetRandomInteger(0,
+          Integer(new CppIntegerData(modulus)));
+      CryptoPP::Integer cexp = CppIntegerData::GetInteger(exp);
+      EXPECT_TRUE(table.Covers(cexp));
+      EXPECT_EQ(a_exp_b_mod_c(generator, cexp, modulus), table.Exponentiate(cexp));
+    }
+
+    // Exponents larger than the table fall back to the plain path
+    CryptoPP::Integer large = modulus * modulus;
+    EXPECT_FALSE(table.Covers(large));
+    EXPECT_EQ(a_exp_b_mod_c(generator, large, modulus), table.Exponentiate(large));
+  }
+
+  TEST(Integer, FixedBaseCache)
+  {
+    CryptoPP::Integer modulus = CppDiffieHellman::GetPInt();
+    CryptoPP::Integer generator = CppDiffieHellman::GetGInt();
+
+    QSharedPointer<const CppFixedBaseTable> table =
+      CppFixedBaseCache::Register(generator, modulus);
+    ASSERT_FALSE(table.isNull());
+    EXPECT_EQ(table, CppFixedBaseCache::Lookup(generator, modulus));
+
+    // Registering twice returns the cached table
+    int count = CppFixedBaseCache::Count();
+    EXPECT_EQ(table, CppFixedBaseCache::Register(generator, modulus));
+    EXPECT_EQ(count, CppFixedBaseCache::Count());
+
+    // Other bases and even moduli have no table
+    EXPECT_TRUE(CppFixedBaseCache::Lookup(generator + 1, modulus).isNull());
+    EXPECT_TRUE(CppFixedBaseCache::Register(generator, modulus + 1).isNull());
+
+    // Pow only uses the table it is handed
+    Integer imodulus(new CppIntegerData(modulus));
+    CppInteger base(generator), mod(modulus);
+    for(int idx = 0; idx < 5; idx++) {
+      CppInteger exp(Integer::GetRandomInteger(0, imodulus));
+      EXPECT_EQ(base.Pow(exp, mod), base.Pow(exp, mod, table.data()));
+    }
+    CppInteger exp(Integer::GetRandomInteger(0, imodulus));
+    EXPECT_EQ(base.Pow(exp, mod), base.Pow(exp, mod, 0));
+  }
+
+  TEST(Integer, DISABLED_FixedBaseBenchmark)
+  {
+    CryptoPP::Integer modulus = CppDiffieHellman::GetPInt();
+    CryptoPP::Integer generator = CppDiffieHellman::GetGInt();
+    Integer imodulus(new CppIntegerData(modulus));
+
+    QElapsedTimer timer;
+    timer.start();
+    CppFixedBaseTable table(generator, modulus);
+    qint64 setup = timer.nsecsElapsed();
+
+    const int count = 100;
+    QVector<CryptoPP::Integer> exps;
+    for(int idx = 0; idx < count; idx++) {
+      exps.append(CppIntegerData::GetInteger(
+            Integer::GetRandomInteger(0, imodulus)));
+    }
+
+    timer.restart();
+    CryptoPP::Integer plain_acc;
+    foreach(const CryptoPP::Integer &exp, exps) {
+      plain_acc += a_exp_b_mod_c(generator, exp, modulus);
+    }
+    qint64 plain = std::max(timer.nsecsElapsed(), qint64(1));
+
+    timer.restart();
+    CryptoPP::Integer table_acc;
+    foreach(const CryptoPP::Integer &exp, exps) {
+      table_acc += table.Exponentiate(exp);
+    }
+    qint64 fixed = std::max(timer.nsecsElapsed(), qint64(1));
+    EXPECT_EQ(plain_acc, table_acc);
+
+    qDebug() << "!BENCHMARK!" << "FixedBase | modulus bits:" <<
+      modulus.BitCount() << "| table entries:" << table.GetTableSize() <<
+      "| setup msecs:" << setup / 1000000.0 <<
+      "| plain usecs/exp:" << plain / 1000.0 / count <<
+      "| table usecs/exp:" << fixed / 1000.0 / count <<
+      "| speedup:" << double(plain) / fixed;
+  }
+
+  TEST(Integer, CppIntegerValue)
+  {
+    Integer imodulus(new CppIntegerData(CppDiffieHellman::GetPInt()));
+    Integer ibase = Integer::GetRandomInteger(0, imodulus);
+    Integer iexp = Integer::GetRandomInteger(0, imodulus);
+    Integer iother = Integer::GetRandomInteger(0, imodulus);
+
+    CppInteger modulus(imodulus), base(ibase), exp(iexp), other(iother);
+    EXPECT_EQ(ibase, base.ToInteger());
+    EXPECT_EQ(ibase.GetByteArray(), base.GetByteArray());
+    EXPECT_EQ(ibase, CppInteger(ibase.GetByteArray()).ToInteger());
+
+    EXPECT_EQ(ibase + iother, (base + other).ToInteger());
+    EXPECT_EQ(ibase - iother, (base - other).ToInteger());
+    EXPECT_EQ(ibase * iother, (base * other).ToInteger());
+    EXPECT_EQ(ibase / iother, (base / other).ToInteger());
+    EXPECT_EQ(ibase % iother, (base % other).ToInteger());
+    EXPECT_EQ(ibase.Pow(iexp, imodulus), base.Pow(exp, modulus).ToInteger());
+    EXPECT_EQ(ibase.CascadePow(iexp, iother, iexp, imodulus),
+        base.CascadePow(exp, other, exp, modulus).ToInteger());
+    EXPECT_EQ((ibase * iother) % imodulus,
+        CppInteger(base).MultiplyMod(other, modulus).ToInteger());
+
+    // The cached encoding follows the value through in-place operations
+    CppInteger value(base);
+    QByteArray encoding = value.GetByteArray();
+    value += other;
+    EXPECT_NE(encoding, value.GetByteArray());
+    EXPECT_EQ((ibase + iother).GetByteArray(), value.GetByteArray());
+    value -= other;
+    EXPECT_EQ(encoding, value.GetByteArray());
+    value *= other;
+    value %= modulus;
+    EXPECT_EQ(((ibase * iother) % imodulus).GetByteArray(),
+        value.GetByteArray());
+
+    value.swap(other);
+    EXPECT_EQ(iother, value.ToInteger());
+    EXPECT_EQ((ibase * iother) % imodulus, other.ToInteger());
+    EXPECT_TRUE(CppInteger(5) < CppInteger(6));
+    EXPECT_TRUE(CppInteger(6) >= CppInteger(6));
+
+    // Serializes like an Integer
+    QByteArray data;
+    QDataStream out_stream(&data, QIODevice::WriteOnly);
+    out_stream << base << ibase;
+    QDataStream in_stream(data);
+    CppInteger cpp_out;
+    Integer int_out;
+    in_stream >> cpp_out >> int_out;
+    EXPECT_EQ(ibase, int_out);
+    EXPECT_EQ(base, cpp_out);
+  }
+
+  TEST(Integer, DISABLED_CppIntegerBenchmark)
+  {
+    CppDsaPrivateKey base_key;
+    CppDsaPrivateKey exp_key(base_key.GetModulus(), base_key.GetSubgroup(),
+        base_key.GetGenerator());
+    Integer iexp = exp_key.GetPrivateExponent();
+
+    const int count = 500;
+    QVector<Integer> keys;
+    for(int idx = 0; idx < count; idx++) {
+      CppDsaPrivateKey key(base_key.GetModulus(), base_key.GetSubgroup(),
+          base_key.GetGenerator());
+      keys.append(key.GetPublicElement());
+    }
+
+    // NeffKeyShuffle::ShuffleKeys, as it was and as it is
+    QElapsedTimer timer;
+    timer.start();
+    QVector<Integer> neff_before;
+    foreach(const Integer &key, keys) {
+      neff_before.append(key.Pow(iexp, base_key.GetModulus()));
+    }
+    qint64 neff_old = std::max(timer.nsecsElapsed(), qint64(1));
+
+    timer.restart();
+    QVector<Integer> neff_after;
+    neff_after.reserve(count);
+    const CppInteger modulus(base_key.GetModulus());
+    const CppInteger exponent(iexp);
+    foreach(const Integer &key, keys) {
+      neff_after.append(CppInteger(key).Pow(exponent, modulus).ToInteger());
+    }
+    qint64 neff_new = std::max(timer.nsecsElapsed(), qint64(1));
+    EXPECT_EQ(neff_before, neff_after);
+
+    // The LRVerifier ring loop, as it was and as it is
+    Integer ig = base_key.GetGenerator();
+    Integer ip = base_key.GetModulus();
+    Integer iq = base_key.GetSubgroup();
+    Integer ihash = ig.Pow(Integer::GetRandomInteger(0, iq), ip);
+    Integer itag = ihash.Pow(iexp, ip);
+    QByteArray prefix(256, 'a');
+    QVector<Integer> si;
+    for(int idx = 0; idx < count; idx++) {
+      si.append(Integer::GetRandomInteger(0, iq));
+    }
+
+    timer.restart();
+    CppHash hash_object;
+    Integer ci = si[0];
+    for(int idx = 0; idx < count; idx++) {
+      Integer zi = ig.CascadePow(si[idx], keys[idx], ci, ip);
+      Integer zi_dash = ihash.CascadePow(si[idx], itag, ci, ip);
+      QByteArray input = prefix + itag.GetByteArray() + zi.GetByteArray() +
+        zi_dash.GetByteArray();
+      hash_object.Restart();
+      ci = Integer(hash_object.ComputeHash(input));
+    }
+    qint64 lrs_old = std::max(timer.nsecsElapsed(), qint64(1));
+
+    QVector<CppInteger> cpp_keys, cpp_si;
+    for(int idx = 0; idx < count; idx++) {
+      cpp_keys.append(CppInteger(keys[idx]));
+      cpp_si.append(CppInteger(si[idx]));
+    }
+
+    timer.restart();
+    const CppInteger g(ig), p(ip), group_hash(ihash), tag(itag);
+    const QByteArray cpp_prefix = prefix + tag.GetByteArray();
+    CppInteger cpp_ci = cpp_si[0], zi, zi_dash;
+    for(int idx = 0; idx < count; idx++) {
+      g.CascadePow(cpp_si[idx], cpp_keys[idx], cpp_ci, p).swap(zi);
+      group_hash.CascadePow(cpp_si[idx], tag, cpp_ci, p).swap(zi_dash);
+      hash_object.Update(cpp_prefix);
+      hash_object.Update(zi.GetByteArray());
+      hash_object.Update(zi_dash.GetByteArray());
+      CppInteger(hash_object.ComputeHash()).swap(cpp_ci);
+    }
+    qint64 lrs_new = std::max(timer.nsecsElapsed(), qint64(1));
+    EXPECT_EQ(ci, cpp_ci.ToInteger());
+
+    qDebug() << "!BENCHMARK!" << "CppInteger | modulus bits:" <<
+      modulus.GetBitCount() << "| iterations:" << count <<
+      "| neff before usecs/op:" << neff_old / 1000.0 / count <<
+      "| neff after usecs/op:" << neff_new / 1000.0 / count <<
+      "| neff speedup:" << double(neff_old) / neff_new <<
+      "| lrs before usecs/op:" << lrs_old / 1000.0 / count <<
+      "| lrs after usecs/op:" << lrs_new / 1000.0 / count <<
+      "| lrs speedup:" << double(lrs_old) / lrs_new;
+  }
 }
 }
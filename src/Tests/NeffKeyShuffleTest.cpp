@@ -1,11 +1,16 @@
+#include <QElapsedTimer>
+
 #include "DissentTest.hpp"
 #include "TestNode.hpp"
 #include "RoundTest.hpp"
 
 namespace Dissent {
 namespace Tests {
-  TEST(NeffKeyShuffle, Basic)
+  void NeffKeyShuffleTest_Basic(bool elliptic_curve)
   {
+    bool use_ec = NeffKeyShuffle::GetEllipticCurve();
+    NeffKeyShuffle::SetEllipticCurve(elliptic_curve);
+
     SessionCreator callback = SessionCreator(TCreateRound<NeffKeyShuffle>);
     Group::SubgroupPolicy sg_policy = Group::ManagedSubgroup;
 
@@ -58,10 +63,110 @@ namespace Tests {
       }
 
       ASSERT_TRUE(kfs->GetAnonymizedKey());
+
+      QSharedPointer<AsymmetricKey> key = kfs->GetAnonymizedKey();
+      QSharedPointer<AsymmetricKey> pkey =
+        kfs->GetAnonymizedKeys()[kfs->GetAnonymizedKeyIndex()];
+      EXPECT_EQ(elliptic_curve, !key.dynamicCast<CppEcPrivateKey>().isNull());
+      EXPECT_EQ(elliptic_curve, !pkey.dynamicCast<CppEcPublicKey>().isNull());
+      EXPECT_TRUE(pkey->VerifyKey(*key));
     }
 
     qDebug() << "Shut down";
     ConnectionManager::UseTimer = true;
+    NeffKeyShuffle::SetEllipticCurve(use_ec);
+  }
+
+  TEST(NeffKeyShuffle, Basic)
+  {
+    NeffKeyShuffleTest_Basic(false);
+  }
+
+  TEST(NeffKeyShuffle, EllipticCurve)
+  {
+    NeffKeyShuffleTest_Basic(true);
+  }
+
+  TEST(NeffKeyShuffle, DISABLED_GroupBenchmark)
+  {
+    const int count = 64;
+    QElapsedTimer timer;
+
+    // A single server's shuffle step: rebase the generator and every key
+    QScopedPointer<CppDsaPrivateKey> base_key(
+        CppDsaPrivateKey::GenerateKey(Id().GetByteArray()));
+    Integer modulus = base_key->GetModulus();
+    Integer subgroup = base_key->GetSubgroup();
+    Integer generator = base_key->GetGenerator();
+
+    QVector<Integer> dsa_keys;
+    for(int idx = 0; idx < count; idx++) {
+      CppDsaPrivateKey key(modulus, subgroup, generator);
+      dsa_keys.append(key.GetPublicElement());
+    }
+
+    CppDsaPrivateKey dsa_exp_key(modulus, subgroup, generator);
+    Integer dsa_exp = dsa_exp_key.GetPrivateExponent();
+    timer.start();
+    Integer dsa_generator = generator.Pow(dsa_exp, modulus);
+    QVector<Integer> dsa_output;
+    foreach(const Integer &key, dsa_keys) {
+      dsa_output.append(key.Pow(dsa_exp, modulus));
+    }
+    qint64 dsa_shuffle = timer.nsecsElapsed();
+
+    QVector<Integer> ec_keys;
+    for(int idx = 0; idx < count; idx++) {
+      CppEcPrivateKey key;
+      ec_keys.append(key.GetPublicElement());
+    }
+
+    Integer ec_exp = CppEcGroup::GetRandomExponent();
+    timer.start();
+    Integer ec_generator = CppEcGroup::Multiply(CppEcGroup::GetGenerator(),
+        ec_exp);
+    QVector<Integer> ec_output;
+    foreach(const Integer &key, ec_keys) {
+      ec_output.append(CppEcGroup::Multiply(key, ec_exp));
+    }
+    qint64 ec_shuffle = timer.nsecsElapsed();
+
+    for(int idx = 0; idx < count; idx++) {
+      EXPECT_TRUE(dsa_output[idx] != 0);
+      EXPECT_TRUE(CppEcGroup::IsElement(ec_output[idx]));
+    }
+
+    // The resulting slot keys
+    QByteArray data(1024, 0);
+    CppRandom().GenerateBlock(data);
+    CppDsaPrivateKey dsa_slot(modulus, subgroup, dsa_generator);
+    CppEcPrivateKey ec_slot(ec_generator);
+    ASSERT_TRUE(dsa_slot.IsValid());
+    ASSERT_TRUE(ec_slot.IsValid());
+
+    QByteArray dsa_sig = dsa_slot.Sign(data);
+    QByteArray ec_sig = ec_slot.Sign(data);
+    timer.start();
+    for(int idx = 0; idx < count; idx++) {
+      EXPECT_TRUE(dsa_slot.Verify(data, dsa_sig));
+    }
+    qint64 dsa_verify = timer.nsecsElapsed();
+
+    timer.start();
+    for(int idx = 0; idx < count; idx++) {
+      EXPECT_TRUE(ec_slot.Verify(data, ec_sig));
+    }
+    qint64 ec_verify = timer.nsecsElapsed();
+
+    qDebug() << "!BENCHMARK!" << "NeffKeyShuffle | keys:" << count <<
+      "| dsa shuffle msecs:" << dsa_shuffle / 1000000.0 <<
+      "| ec shuffle msecs:" << ec_shuffle / 1000000.0 <<
+      "| dsa element bytes:" << dsa_output[0].GetByteArray().size() <<
+      "| ec element bytes:" << ec_output[0].GetByteArray().size() <<
+      "| dsa signature bytes:" << dsa_sig.size() <<
+      "| ec signature bytes:" << ec_sig.size() <<
+      "| dsa verify usecs:" << dsa_verify / 1000.0 / count <<
+      "| ec verify usecs:" << ec_verify / 1000.0 / count;
   }
 
   TEST(NeffKeyShuffle, Disconnect)
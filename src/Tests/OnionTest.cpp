@@ -1,3 +1,5 @@
+#include <QElapsedTimer>
+
 #include "DissentTest.hpp"
 
 namespace Dissent {
@@ -433,5 +435,199 @@ namespace Tests {
     ThreadedOnionEncryptor oe;
     SoMuchEvil(oe);
   }
+  TEST(Crypto, SizedPoolMultithreaded)
+  {
+    ThreadedOnionEncryptor oe(3);
+    EXPECT_EQ(3, oe.GetThreadCount());
+    ShufflePrimitivesTest(oe);
+    SoMuchEvil(oe);
+
+    oe.SetThreadCount(1);
+    EXPECT_EQ(1, oe.GetThreadCount());
+    CryptoTextSwapTest(oe);
+
+    oe.SetThreadCount(0);
+    EXPECT_TRUE(oe.GetThreadCount() >= 1);
+  }
+
+  TEST(Crypto, DISABLED_VerifyAllBenchmark)
+  {
+    int keys = 5;
+    int count = 50;
+
+    Library *lib = CryptoFactory::GetInstance().GetLibrary();
+
+    QVector<QSharedPointer<AsymmetricKey> > private_keys;
+    QVector<QSharedPointer<AsymmetricKey> > public_keys;
+    for(int idx = 0; idx < keys; idx++) {
+      private_keys.append(QSharedPointer<AsymmetricKey>(lib->CreatePrivateKey()));
+      public_keys.append(QSharedPointer<AsymmetricKey>(private_keys.last()->GetPublicKey()));
+    }
+
+    QVector<QVector<QByteArray> > onions(keys + 1);
+    QScopedPointer<Random> rand(lib->GetRandomNumberGenerator());
+    OnionEncryptor soe;
+
+    for(int idx = 0; idx < count; idx++) {
+      QByteArray cleartext(1500, 0);
+      rand->GenerateBlock(cleartext);
+      QByteArray ciphertext;
+      QVector<QByteArray> intermediate;
+      EXPECT_EQ(soe.Encrypt(public_keys, cleartext, ciphertext, &intermediate), -1);
+
+      onions[0].append(cleartext);
+      for(int jdx = 0; jdx < intermediate.count(); jdx++) {
+        onions[jdx + 1].append(intermediate[jdx]);
+      }
+      onions[keys].append(ciphertext);
+    }
+
+    ThreadedOnionEncryptor toe;
+    QElapsedTimer timer;
+    QBitArray bad;
+
+    timer.start();
+    EXPECT_TRUE(soe.VerifyAll(private_keys, onions, bad));
+    qint64 single = timer.elapsed();
+
+    timer.restart();
+    EXPECT_TRUE(toe.VerifyAll(private_keys, onions, bad));
+    qint64 multi = timer.elapsed();
+
+    qDebug() << "!BENCHMARK!" << "VerifyAll | keys:" << keys << "| messages:" <<
+      count << "| single (ms):" << single << "| threads:" <<
+      toe.GetThreadCount() << "| threaded (ms):" << multi;
+  }
+  void DecryptWithDigestsTest(OnionEncryptor &oe)
+  {
+    int count = 20;
+    Library *lib = CryptoFactory::GetInstance().GetLibrary();
+    QSharedPointer<AsymmetricKey> private_key(lib->CreatePrivateKey());
+    QSharedPointer<AsymmetricKey> public_key(private_key->GetPublicKey());
+
+    QVector<QByteArray> cleartexts;
+    QVector<QByteArray> ciphertexts;
+    QScopedPointer<Random> rand(lib->GetRandomNumberGenerator());
+    for(int idx = 0; idx < count; idx++) {
+      QByteArray cleartext(1500, 0);
+      rand->GenerateBlock(cleartext);
+      cleartexts.append(cleartext);
+      ciphertexts.append(public_key->Encrypt(cleartext));
+    }
+    ciphertexts[count / 2] = QByteArray(10, 0);
+
+    QVector<QByteArray> output, digests;
+    QVector<int> bad;
+    EXPECT_FALSE(oe.DecryptWithDigests(private_key, ciphertexts, output,
+          digests, &bad));
+    EXPECT_EQ(count, output.count());
+    EXPECT_EQ(count, digests.count());
+    EXPECT_EQ(1, bad.count());
+    EXPECT_EQ(count / 2, bad.first());
+
+    QScopedPointer<Hash> hash(lib->GetHashAlgorithm());
+    for(int idx = 0; idx < count; idx++) {
+      EXPECT_EQ(hash->ComputeHash(ciphertexts[idx]), digests[idx]);
+      if(idx != count / 2) {
+        EXPECT_EQ(cleartexts[idx], output[idx]);
+      }
+    }
+  }
+
+  TEST(Crypto, DecryptWithDigestsSingleThreaded)
+  {
+    OnionEncryptor oe;
+    DecryptWithDigestsTest(oe);
+  }
+
+  TEST(Crypto, DecryptWithDigestsMultithreaded)
+  {
+    ThreadedOnionEncryptor oe;
+    DecryptWithDigestsTest(oe);
+  }
+
+  TEST(Crypto, RandomizeBlocksUniform)
+  {
+    OnionEncryptor oe;
+    QVector<QByteArray> blocks;
+    blocks << QByteArray("a") << QByteArray("b") << QByteArray("c");
+
+    // Every ordering of three blocks should be equally likely
+    int runs = 30000;
+    QHash<QByteArray, int> orders;
+    for(int idx = 0; idx < runs; idx++) {
+      QVector<QByteArray> text = blocks;
+      oe.RandomizeBlocks(text);
+      orders[text[0] + text[1] + text[2]]++;
+    }
+
+    EXPECT_EQ(6, orders.count());
+    foreach(int seen, orders) {
+      EXPECT_TRUE(seen > runs / 6 - 300);
+      EXPECT_TRUE(seen < runs / 6 + 300);
+    }
+  }
+
+  TEST(Crypto, DISABLED_ShuffleStepBenchmark)
+  {
+    Library *lib = CryptoFactory::GetInstance().GetLibrary();
+    QSharedPointer<AsymmetricKey> private_key(lib->CreatePrivateKey());
+    QSharedPointer<AsymmetricKey> public_key(private_key->GetPublicKey());
+    QScopedPointer<Random> rand(lib->GetRandomNumberGenerator());
+    ThreadedOnionEncryptor oe;
+    QElapsedTimer timer;
+
+    QList<int> sizes;
+    sizes << 32 << 128 << 512;
+
+    foreach(int count, sizes) {
+      QVector<QByteArray> ciphertexts;
+      for(int idx = 0; idx < count; idx++) {
+        QByteArray cleartext(ShuffleRound::DefaultData.size(), 0);
+        rand->GenerateBlock(cleartext);
+        ciphertexts.append(public_key->Encrypt(cleartext));
+      }
+
+      // The pairwise scan the shuffle used before digests
+      timer.start();
+      bool duplicate = false;
+      for(int idx = 0; idx < count; idx++) {
+        for(int jdx = 0; jdx < count; jdx++) {
+          if(idx != jdx && ciphertexts[idx] == ciphertexts[jdx]) {
+            duplicate = true;
+          }
+        }
+      }
+      qint64 pairwise = timer.nsecsElapsed();
+      EXPECT_FALSE(duplicate);
+
+      // Decrypt and digest, find duplicates, then permute
+      timer.restart();
+      QVector<QByteArray> output, digests;
+      EXPECT_TRUE(oe.DecryptWithDigests(private_key, ciphertexts, output,
+            digests));
+      qint64 decrypt = timer.nsecsElapsed();
+
+      timer.restart();
+      QSet<QByteArray> seen;
+      foreach(const QByteArray &digest, digests) {
+        duplicate |= seen.contains(digest);
+        seen.insert(digest);
+      }
+      qint64 hashed = timer.nsecsElapsed();
+      EXPECT_FALSE(duplicate);
+
+      timer.restart();
+      oe.RandomizeBlocks(output);
+      qint64 randomize = timer.nsecsElapsed();
+
+      qDebug() << "!BENCHMARK!" << "Shuffle step | N:" << count <<
+        "| pairwise dedup (us):" << pairwise / 1000 <<
+        "| digest dedup (us):" << hashed / 1000 <<
+        "| decrypt+digest (ms):" << decrypt / 1000000 <<
+        "| randomize (us):" << randomize / 1000 <<
+        "| step (ms):" << (decrypt + hashed + randomize) / 1000000;
+    }
+  }
 }
 }
@@ -0,0 +1,203 @@
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  PadGenerator::KeystreamList CreateKeystreams(Library *lib, int count)
+  {
+    QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+    QByteArray nonce(4, 0);
+    rng->GenerateBlock(nonce);
+
+    PadGenerator::KeystreamList rngs;
+    for(int idx = 0; idx < count; idx++) {
+      QByteArray seed(lib->RngOptimalSeedSize(), 0);
+      rng->GenerateBlock(seed);
+      rngs.append(QSharedPointer<KeystreamGenerator>(
+            lib->GetKeystreamGenerator(seed, nonce)));
+    }
+    return rngs;
+  }
+
+  PadGenerator::KeystreamList CloneKeystreams(Library *lib,
+      const QList<QByteArray> &seeds, const QByteArray &nonce)
+  {
+    PadGenerator::KeystreamList rngs;
+    foreach(const QByteArray &seed, seeds) {
+      rngs.append(QSharedPointer<KeystreamGenerator>(
+            lib->GetKeystreamGenerator(seed, nonce)));
+    }
+    return rngs;
+  }
+
+  void PadGeneratorTest(Library *lib)
+  {
+    QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+    QByteArray nonce(4, 0);
+    rng->GenerateBlock(nonce);
+
+    QList<QByteArray> seeds;
+    for(int idx = 0; idx < 37; idx++) {
+      QByteArray seed(lib->RngOptimalSeedSize(), 0);
+      rng->GenerateBlock(seed);
+      seeds.append(seed);
+    }
+
+    // Serial reference, two phases worth of pads
+    int length = 5000;
+    PadGenerator::KeystreamList serial_rngs = CloneKeystreams(lib, seeds, nonce);
+    QByteArray expected0(length, 0);
+    QByteArray expected1(length, 0);
+    QByteArray tmp(length, 0);
+    foreach(const QSharedPointer<KeystreamGenerator> &ks, serial_rngs) {
+      ks->GenerateBlock(tmp);
+      XorKernel::XorInPlace(expected0, tmp);
+    }
+    foreach(const QSharedPointer<KeystreamGenerator> &ks, serial_rngs) {
+      ks->GenerateBlock(tmp);
+      XorKernel::XorInPlace(expected1, tmp);
+    }
+
+    QList<int> thread_counts;
+    thread_counts << 1 << 2 << 3 << 8 << 64;
+    foreach(int threads, thread_counts) {
+      PadGenerator::KeystreamList rngs = CloneKeystreams(lib, seeds, nonce);
+      QByteArray pad0(length, 0);
+      PadGenerator::XorPads(rngs, pad0, threads);
+      EXPECT_EQ(expected0, pad0);
+
+      QByteArray pad1(length, 0);
+      PadGenerator::XorPads(rngs, pad1, threads);
+      EXPECT_EQ(expected1, pad1);
+
+      foreach(const QSharedPointer<KeystreamGenerator> &ks, rngs) {
+        EXPECT_EQ(quint64(2 * length), ks->GetPosition());
+      }
+    }
+
+    QByteArray empty;
+    PadGenerator::XorPads(CloneKeystreams(lib, seeds, nonce), empty, 4);
+    EXPECT_TRUE(empty.isEmpty());
+  }
+
+  TEST(PadGenerator, Cpp)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    int threads = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    PadGeneratorTest(lib.data());
+    CryptoFactory::GetInstance().SetThreadCount(threads);
+  }
+
+  TEST(PadGenerator, Null)
+  {
+    QScopedPointer<Library> lib(new NullLibrary());
+    int threads = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    PadGeneratorTest(lib.data());
+    CryptoFactory::GetInstance().SetThreadCount(threads);
+  }
+
+  void PadCacheTest(qint64 max_bytes)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+    QByteArray nonce(4, 0);
+    rng->GenerateBlock(nonce);
+
+    QList<QByteArray> seeds;
+    for(int idx = 0; idx < 20; idx++) {
+      QByteArray seed(lib->RngOptimalSeedSize(), 0);
+      rng->GenerateBlock(seed);
+      seeds.append(seed);
+    }
+
+    int length = 1000;
+    PadGenerator::KeystreamList rngs = CloneKeystreams(lib.data(), seeds, nonce);
+    QHash<int, QSharedPointer<KeystreamGenerator> > keyed;
+    for(int idx = 0; idx < rngs.count(); idx++) {
+      keyed[idx] = rngs[idx];
+    }
+
+    // Only every third keystream participates, plus an unknown key
+    QList<int> keys;
+    PadGenerator::KeystreamList selected;
+    for(int idx = 0; idx < seeds.count(); idx += 3) {
+      keys.append(idx);
+      selected.append(QSharedPointer<KeystreamGenerator>(
+            lib->GetKeystreamGenerator(seeds[idx], nonce)));
+    }
+    keys.append(seeds.count());
+
+    QByteArray expected(length, 0);
+    PadGenerator::XorPads(selected, expected, 1);
+
+    PadCache cache(max_bytes);
+    cache.Precompute(keyed, length);
+    EXPECT_EQ(int(std::min(qint64(seeds.count()), max_bytes / length)),
+        cache.GetCachedCount());
+
+    QByteArray pad(length, 0);
+    EXPECT_EQ(selected.count(), cache.XorPads(keys, pad));
+    EXPECT_EQ(expected, pad);
+    EXPECT_EQ(0, cache.GetCachedCount());
+
+    // A different length rewinds and regenerates the keystreams
+    PadGenerator::KeystreamList fresh = CloneKeystreams(lib.data(), seeds, nonce);
+    for(int idx = 0; idx < fresh.count(); idx++) {
+      keyed[idx] = fresh[idx];
+    }
+
+    cache.Precompute(keyed, length);
+    QByteArray longer(2 * length, 0);
+    QByteArray longer_expected(2 * length, 0);
+    PadGenerator::XorPads(CloneKeystreams(lib.data(), QList<QByteArray>() <<
+          seeds[0] << seeds[3], nonce), longer_expected, 1);
+    EXPECT_EQ(2, cache.XorPads(QList<int>() << 0 << 3, longer));
+    EXPECT_EQ(longer_expected, longer);
+  }
+
+  TEST(PadGenerator, Cache)
+  {
+    int threads = CryptoFactory::GetInstance().GetThreadCount();
+    CryptoFactory::GetInstance().SetThreadCount(4);
+    PadCacheTest(PadCache::DEFAULT_MAX_BYTES);
+    PadCacheTest(7000);
+    PadCacheTest(0);
+    CryptoFactory::GetInstance().SetThreadCount(threads);
+  }
+
+  TEST(PadGenerator, DISABLED_Benchmark)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    int original = CryptoFactory::GetInstance().GetThreadCount();
+    int cores = std::max(1, QThread::idealThreadCount());
+
+    int clients = 1000;
+    int length = 16 * 1024;
+    PadGenerator::KeystreamList rngs = CreateKeystreams(lib.data(), clients);
+    QByteArray pad(length, 0);
+
+    qint64 serial = 0;
+    for(int threads = 1; threads <= cores; threads *= 2) {
+      CryptoFactory::GetInstance().SetThreadCount(threads);
+      QElapsedTimer timer;
+      timer.start();
+      PadGenerator::XorPads(rngs, pad, threads);
+      qint64 elapsed = std::max(timer.nsecsElapsed(), qint64(1));
+      if(threads == 1) {
+        serial = elapsed;
+      }
+
+      qDebug() << "!BENCHMARK!" << "PadGenerator | clients:" << clients <<
+        "| bytes:" << length << "| threads:" << threads <<
+        "| msecs:" << elapsed / 1000000.0 <<
+        "| speedup:" << double(serial) / elapsed;
+    }
+
+    CryptoFactory::GetInstance().SetThreadCount(original);
+  }
+}
+}
@@ -1,3 +1,7 @@
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QThreadPool>
+
 #include "DissentTest.hpp"
 
 namespace Dissent {
@@ -56,6 +60,88 @@ namespace Tests {
     }
   }
 
+  void KeystreamTest(Library *lib)
+  {
+    QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+    QByteArray seed(lib->RngOptimalSeedSize(), 0);
+    rng->GenerateBlock(seed);
+
+    QByteArray nonce0(4, 0);
+    QByteArray nonce1(4, 0);
+    nonce1[0] = 1;
+
+    QScopedPointer<KeystreamGenerator> ks0(lib->GetKeystreamGenerator(seed, nonce0));
+    QScopedPointer<KeystreamGenerator> ks1(lib->GetKeystreamGenerator(seed, nonce0));
+    QScopedPointer<KeystreamGenerator> ks2(lib->GetKeystreamGenerator(seed, nonce1));
+
+    QByteArray stream0(4096, 0);
+    ks0->GenerateBlock(stream0);
+    EXPECT_EQ(ks0->GetPosition(), quint64(stream0.size()));
+    EXPECT_EQ(ks0->BytesGenerated(), uint(stream0.size()));
+
+    // Same seed and nonce produce the same stream, regardless of chunking
+    QByteArray stream1;
+    for(int idx = 0; idx < stream0.size(); idx += 37) {
+      QByteArray chunk(std::min(37, stream0.size() - idx), 0);
+      ks1->GenerateBlock(chunk);
+      stream1.append(chunk);
+    }
+    EXPECT_EQ(stream0, stream1);
+
+    // A different nonce produces an unrelated stream, even shifted by a block
+    QByteArray stream2(4096, 0);
+    ks2->GenerateBlock(stream2);
+    EXPECT_NE(stream0, stream2);
+    EXPECT_NE(stream0.mid(16), stream2.left(4096 - 16));
+    EXPECT_NE(stream0.left(4096 - 16), stream2.mid(16));
+
+    // Long nonces that differ by the same byte 8 apart do not collide
+    QByteArray nonce2(16, 0);
+    QByteArray nonce3(16, 0);
+    nonce3[0] = 1;
+    nonce3[8] = 1;
+    QScopedPointer<KeystreamGenerator> ks3(lib->GetKeystreamGenerator(seed, nonce2));
+    QScopedPointer<KeystreamGenerator> ks4(lib->GetKeystreamGenerator(seed, nonce3));
+    QByteArray stream3(64, 0);
+    QByteArray stream4(64, 0);
+    ks3->GenerateBlock(stream3);
+    ks4->GenerateBlock(stream4);
+    EXPECT_NE(stream3, stream4);
+
+    // No nonce is the empty nonce
+    QScopedPointer<KeystreamGenerator> ks5(lib->GetKeystreamGenerator(seed));
+    QScopedPointer<KeystreamGenerator> ks6(
+        lib->GetKeystreamGenerator(seed, QByteArray()));
+    QByteArray stream5(64, 0);
+    QByteArray stream6(64, 0);
+    ks5->GenerateBlock(stream5);
+    ks6->GenerateBlock(stream6);
+    EXPECT_EQ(stream5, stream6);
+
+    // Seeking to any offset matches the sequential stream
+    for(int idx = 0; idx < 20; idx++) {
+      int offset = rng->GetInt(0, stream0.size() - 64);
+      int length = rng->GetInt(1, 64);
+      ks1->Seek(offset);
+      QByteArray part(length, 0);
+      ks1->GenerateBlock(part);
+      EXPECT_EQ(stream0.mid(offset, length), part);
+      EXPECT_EQ(ks1->GetPosition(), quint64(offset + length));
+    }
+
+    // Xoring the keystream twice restores the input
+    QByteArray msg(1000, 0);
+    rng->GenerateBlock(msg);
+    QByteArray xored = msg;
+    ks1->Seek(100);
+    ks1->XorBlock(xored);
+    EXPECT_NE(msg, xored);
+    EXPECT_EQ(char(stream0[100] ^ msg[0]), xored[0]);
+    ks1->Seek(100);
+    ks1->XorBlock(xored);
+    EXPECT_EQ(msg, xored);
+  }
+
   TEST(Random, BaseRandomTest)
   {
     RandomTest(&Random::GetInstance());
@@ -67,6 +153,79 @@ namespace Tests {
     RandomTest(rand.data());
   }
 
+  class PooledHandleGrabber : public QRunnable {
+    public:
+      explicit PooledHandleGrabber(CryptoPP::RandomNumberGenerator **handle) :
+        _handle(handle)
+      {
+      }
+
+      virtual void run()
+      {
+        CppRandom rand;
+        *_handle = rand.GetHandle();
+      }
+
+    private:
+      CryptoPP::RandomNumberGenerator **_handle;
+  };
+
+  TEST(Random, CppPooledRandomTest)
+  {
+    CppRandom rand0;
+    CppRandom rand1;
+    EXPECT_EQ(rand0.GetHandle(), rand1.GetHandle());
+    EXPECT_EQ(rand0.GetHandle(), &CppRandom::GetPooledGenerator());
+
+    QByteArray seed(20, 1);
+    CppRandom seeded(seed);
+    EXPECT_NE(rand0.GetHandle(), seeded.GetHandle());
+
+    // Output stays fresh across a reseed
+    QByteArray first(CppRandom::RESEED_BYTES + 100, 0);
+    QByteArray second(1000, 0);
+    rand0.GenerateBlock(first);
+    rand1.GenerateBlock(second);
+    EXPECT_NE(first.left(second.size()), second);
+    EXPECT_NE(first.right(second.size()), second);
+    RandomTest(&rand1);
+
+    // Every thread has its own generator
+    CryptoPP::RandomNumberGenerator *other = 0;
+    QThreadPool pool;
+    pool.start(new PooledHandleGrabber(&other));
+    pool.waitForDone();
+    EXPECT_TRUE(other != 0);
+    EXPECT_NE(rand0.GetHandle(), other);
+  }
+
+  TEST(Random, DISABLED_CppPooledRandomBenchmark)
+  {
+    const int count = 1000;
+    QByteArray data(32, 0);
+    QElapsedTimer timer;
+
+    timer.start();
+    for(int idx = 0; idx < count; idx++) {
+      CryptoPP::AutoSeededX917RNG<CryptoPP::AES> rng;
+      rng.GenerateBlock(reinterpret_cast<byte *>(data.data()), data.size());
+    }
+    qint64 auto_seeded = timer.nsecsElapsed();
+
+    QScopedPointer<Library> lib(new CppLibrary());
+    timer.start();
+    for(int idx = 0; idx < count; idx++) {
+      QScopedPointer<Random> rng(lib->GetRandomNumberGenerator());
+      rng->GenerateBlock(data);
+    }
+    qint64 pooled = std::max(timer.nsecsElapsed(), qint64(1));
+
+    qDebug() << "!BENCHMARK!" << "CppRandom | generators:" << count <<
+      "| auto seeded usecs:" << auto_seeded / 1000.0 / count <<
+      "| pooled usecs:" << pooled / 1000.0 / count <<
+      "| speedup:" << double(auto_seeded) / pooled;
+  }
+
   TEST(Random, RandomSeedTest)
   {
     QScopedPointer<Library> lib(new NullLibrary());
@@ -90,5 +249,17 @@ namespace Tests {
     QScopedPointer<Library> lib(new CppLibrary());
     SeededRandomTest(lib.data());
   }
+
+  TEST(Random, CppKeystreamTest)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    KeystreamTest(lib.data());
+  }
+
+  TEST(Random, NullKeystreamTest)
+  {
+    QScopedPointer<Library> lib(new NullLibrary());
+    KeystreamTest(lib.data());
+  }
 }
 }
@@ -44,7 +44,8 @@ namespace Tests {
       "--log" << "stderr" << "--console" <<
       "--web_server_url" << "http://127.0.0.1:8000" <<
       "--entry_tunnel_url" << "tcp://127.0.0.1:8081" <<
-      "--exit_tunnel" << "--multithreading" <<
+      "--exit_tunnel" << "--multithreading" << "--crypto_threads" << "4" <<
+      "--phases_in_flight" << "3" <<
       "--local_id" << "'HJf+qfK7oZVR3dOqeUQcM8TGeVA='" <<
       "--subgroup_policy" << "ManagedSubgroup" <<
       "--super_peer";
@@ -67,6 +68,8 @@ namespace Tests {
     EXPECT_TRUE(settings2.EntryTunnel);
     EXPECT_TRUE(settings2.ExitTunnel);
     EXPECT_TRUE(settings2.Multithreading);
+    EXPECT_EQ(settings2.CryptoThreads, 4);
+    EXPECT_EQ(settings2.PhasesInFlight, 3);
     EXPECT_TRUE(settings2.SuperPeer);
   }
 
@@ -97,20 +97,7 @@ namespace Tests {
         } 
         
         oe->RandomizeBlocks(_server_state->shuffle_output);
-        
-        const Id &next = GetShufflers().Next(GetLocalId());
-        MessageType mtype = (next == Id::Zero()) ? ENCRYPTED_DATA : SHUFFLE_DATA;
-        
-        QByteArray msg;
-        QDataStream out_stream(&msg, QIODevice::WriteOnly);
-        out_stream << mtype << GetRoundId() << _server_state->shuffle_output;
-          
-        if(mtype == ENCRYPTED_DATA) {
-          VerifiableBroadcast(msg);
-        } else {
-          VerifiableSend(next, msg);
-        }
-
+        SendShuffleOutput();
         _state_machine.StateComplete();
       }
   };
@@ -16,6 +16,16 @@ namespace Tests {
         Group::CompleteGroup);
   }
 
+  TEST(ShuffleRound, BasicEc)
+  {
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    CryptoFactory::LibraryName cname = cf.GetLibraryName();
+    cf.SetLibrary(CryptoFactory::CryptoPPEc);
+    RoundTest_Basic(SessionCreator(TCreateRound<ShuffleRound>),
+        Group::CompleteGroup);
+    cf.SetLibrary(cname);
+  }
+
   TEST(ShuffleRound, MultiRound)
   {
     RoundTest_MultiRound(SessionCreator(TCreateRound<ShuffleRound>),
@@ -180,6 +190,85 @@ namespace Tests {
         Group::ManagedSubgroup);
   }
 
+  TEST(ShuffleRound, BasicChunked)
+  {
+    int chunk_size = ShuffleRound::GetShuffleChunkSize();
+    ShuffleRound::SetShuffleChunkSize(2);
+    RoundTest_Basic(SessionCreator(TCreateRound<ShuffleRound>),
+        Group::CompleteGroup);
+    ShuffleRound::SetShuffleChunkSize(chunk_size);
+  }
+
+  TEST(ShuffleRound, MessageDuplicatorChunked)
+  {
+    typedef ShuffleRoundMessageDuplicator<1> bad_shuffle;
+
+    int chunk_size = ShuffleRound::GetShuffleChunkSize();
+    ShuffleRound::SetShuffleChunkSize(1);
+    RoundTest_BadGuy(SessionCreator(TCreateRound<ShuffleRound>),
+        SessionCreator(TCreateRound<bad_shuffle>),
+        Group::CompleteGroup,
+        TBadGuyCB<bad_shuffle>);
+    ShuffleRound::SetShuffleChunkSize(chunk_size);
+  }
+
+  TEST(ShuffleRound, MessageSwitcherChunked)
+  {
+    typedef ShuffleRoundMessageSwitcher<1> bad_shuffle;
+
+    int chunk_size = ShuffleRound::GetShuffleChunkSize();
+    ShuffleRound::SetShuffleChunkSize(3);
+    RoundTest_BadGuy(SessionCreator(TCreateRound<ShuffleRound>),
+        SessionCreator(TCreateRound<bad_shuffle>),
+        Group::FixedSubgroup,
+        TBadGuyCB<bad_shuffle>);
+    ShuffleRound::SetShuffleChunkSize(chunk_size);
+  }
+
+  TEST(ShuffleRound, BasicChunkedThreaded)
+  {
+    // Chunks smaller than the thread count are decrypted in batches that
+    // span chunks, whatever is left over is decrypted by Shuffle
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    int threads = cf.GetThreadCount();
+    cf.SetThreadCount(4);
+    int chunk_size = ShuffleRound::GetShuffleChunkSize();
+    ShuffleRound::SetShuffleChunkSize(3);
+    RoundTest_Basic(SessionCreator(TCreateRound<ShuffleRound>),
+        Group::CompleteGroup);
+    ShuffleRound::SetShuffleChunkSize(chunk_size);
+    cf.SetThreadCount(threads);
+  }
+
+  TEST(ShuffleRound, InvalidOuterEncryptionParallelBlame)
+  {
+    typedef ShuffleRoundInvalidOuterEncryption<1> bad_shuffle;
+
+    // Blame replays each member's log on its own thread
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    int threads = cf.GetThreadCount();
+    cf.SetThreadCount(4);
+    RoundTest_BadGuy(SessionCreator(TCreateRound<ShuffleRound>),
+        SessionCreator(TCreateRound<bad_shuffle>),
+        Group::CompleteGroup,
+        TBadGuyCB<bad_shuffle>);
+    cf.SetThreadCount(threads);
+  }
+
+  TEST(ShuffleRound, MessageSwitcherParallelBlame)
+  {
+    typedef ShuffleRoundMessageSwitcher<1> bad_shuffle;
+
+    CryptoFactory &cf = CryptoFactory::GetInstance();
+    int threads = cf.GetThreadCount();
+    cf.SetThreadCount(4);
+    RoundTest_BadGuy(SessionCreator(TCreateRound<ShuffleRound>),
+        SessionCreator(TCreateRound<bad_shuffle>),
+        Group::FixedSubgroup,
+        TBadGuyCB<bad_shuffle>);
+    cf.SetThreadCount(threads);
+  }
+
   // @todo the transient test fails for CS groups, where the disconnector
   // is the client... The leader will just quickly reinit the group without
   // waiting for the client to come back online.
@@ -0,0 +1,110 @@
+#include <QElapsedTimer>
+
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  void SlotRandomizerRoundTrip(Library *lib)
+  {
+    SlotRandomizer randomizer(lib);
+    SlotRandomizer other(lib);
+    EXPECT_EQ(int(lib->RngOptimalSeedSize()), randomizer.GetSeedSize());
+
+    CppRandom rand;
+    for(int count = 0; count < 50; count++) {
+      QByteArray msg(rand.GetInt(0, 4096), 0);
+      rand.GenerateBlock(msg);
+
+      QByteArray randomized = randomizer.Randomize(msg);
+      EXPECT_EQ(randomizer.GetSeedSize() + msg.size(), randomized.size());
+      EXPECT_FALSE(SlotRandomizer::IsNullSeed(randomized.constData(),
+            randomizer.GetSeedSize()));
+      if(msg.size() > 16) {
+        EXPECT_NE(msg, randomized.mid(randomizer.GetSeedSize()));
+      }
+
+      // Any randomizer from the same library can decode it
+      EXPECT_EQ(msg, other.Derandomize(randomized));
+      EXPECT_EQ(msg, randomizer.Derandomize(randomized));
+
+      // Seeds are fresh for each message
+      EXPECT_NE(randomized, randomizer.Randomize(msg));
+    }
+
+    QByteArray empty(randomizer.GetSeedSize() + 100, 0);
+    EXPECT_TRUE(randomizer.Derandomize(empty).isEmpty());
+    EXPECT_TRUE(randomizer.Derandomize(QByteArray(1, 1)).isEmpty());
+  }
+
+  TEST(SlotRandomizer, CppRoundTrip)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    SlotRandomizerRoundTrip(lib.data());
+  }
+
+  TEST(SlotRandomizer, NullRoundTrip)
+  {
+    QScopedPointer<Library> lib(new NullLibrary());
+    SlotRandomizerRoundTrip(lib.data());
+  }
+
+  TEST(SlotRandomizer, CSBulkRound)
+  {
+    QByteArray msg(1000, 0);
+    CppRandom().GenerateBlock(msg);
+    QByteArray randomized = CSBulkRound::Randomize(msg);
+    EXPECT_EQ(msg, CSBulkRound::Derandomize(randomized));
+
+    QByteArray empty = CSBulkRound::NullSeed() + QByteArray(10, 0);
+    EXPECT_TRUE(CSBulkRound::Derandomize(empty).isEmpty());
+  }
+
+  TEST(SlotRandomizer, DISABLED_Benchmark)
+  {
+    QScopedPointer<Library> lib(new CppLibrary());
+    SlotRandomizer randomizer(lib.data());
+    const qint64 total = 16 * 1024 * 1024;
+
+    for(int size = 64; size <= 1024 * 1024; size *= 4) {
+      QByteArray msg(size, 0);
+      CppRandom().GenerateBlock(msg);
+      int iterations = std::max(qint64(1), total / size);
+
+      QElapsedTimer timer;
+      timer.start();
+      QByteArray randomized;
+      for(int idx = 0; idx < iterations; idx++) {
+        randomized = randomizer.Randomize(msg);
+      }
+      qint64 encode = std::max(timer.nsecsElapsed(), qint64(1));
+
+      timer.restart();
+      QByteArray decoded;
+      for(int idx = 0; idx < iterations; idx++) {
+        decoded = randomizer.Derandomize(randomized);
+      }
+      qint64 decode = std::max(timer.nsecsElapsed(), qint64(1));
+      EXPECT_EQ(msg, decoded);
+
+      // The previous approach: a fresh seeded rng and an intermediate pad
+      timer.restart();
+      for(int idx = 0; idx < iterations; idx++) {
+        QByteArray seed = QByteArray::fromRawData(randomized.constData(),
+            randomizer.GetSeedSize());
+        QScopedPointer<Random> rng(lib->GetRandomNumberGenerator(seed));
+        QByteArray random_text(size, 0);
+        rng->GenerateBlock(random_text);
+        XorKernel::XorInPlace(random_text, msg);
+        decoded = random_text;
+      }
+      qint64 legacy = std::max(timer.nsecsElapsed(), qint64(1));
+
+      double mbytes = double(size) * iterations / (1024 * 1024);
+      qDebug() << "!BENCHMARK!" << "SlotRandomizer | bytes:" << size <<
+        "| encode MB/s:" << mbytes / (encode / 1000000000.0) <<
+        "| decode MB/s:" << mbytes / (decode / 1000000000.0) <<
+        "| per-message rng MB/s:" << mbytes / (legacy / 1000000000.0);
+    }
+  }
+}
+}
@@ -0,0 +1,144 @@
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  TEST(SubmissionDeadline, NoHistory)
+  {
+    SubmissionDeadline deadline(1000, 120000);
+    EXPECT_EQ(qint64(120000), deadline.GetHardDeadline());
+    EXPECT_EQ(qint64(1000), deadline.GetFlexWindow(500));
+    EXPECT_EQ(qint64(5000), deadline.GetFlexWindow(5000));
+    EXPECT_EQ(qint64(-1), deadline.GetPercentile(.5));
+    EXPECT_EQ(qint64(-1), deadline.GetClientLatency(Id()));
+  }
+
+  TEST(SubmissionDeadline, Adapts)
+  {
+    SubmissionDeadline deadline(1000, 120000, .9, 2.0, .5);
+    QList<Id> clients;
+    for(int idx = 0; idx < 100; idx++) {
+      clients.append(Id());
+    }
+
+    // Fast deployment: everyone arrives within ~2 seconds
+    for(int phase = 0; phase < 5; phase++) {
+      for(int idx = 0; idx < clients.count(); idx++) {
+        deadline.AddArrival(clients[idx], 20 * idx);
+      }
+      deadline.PhaseFinished(2000, QList<Id>(), 2000);
+    }
+
+    qint64 p90 = deadline.GetPercentile(.9);
+    EXPECT_GE(p90, qint64(1800));
+    EXPECT_LE(p90, qint64(2400));
+    qint64 fast = deadline.GetHardDeadline();
+    EXPECT_LT(fast, qint64(6000));
+    EXPECT_GE(fast, qint64(1000));
+    EXPECT_EQ(deadline.GetFlexWindow(1000), qint64(1000));
+    // Stragglers always get the minimum window, even during a slowdown
+    EXPECT_EQ(qint64(1000), deadline.GetFlexWindow(10000));
+
+    // The slowdown dominates once the old history decays
+    QList<Id> late = clients.mid(97);
+    for(int phase = 0; phase < 5; phase++) {
+      for(int idx = 0; idx < clients.count() - late.count(); idx++) {
+        deadline.AddArrival(clients[idx], 200 * idx);
+      }
+      deadline.PhaseFinished(20000, late, 20000);
+    }
+
+    EXPECT_GT(deadline.GetHardDeadline(), fast);
+    EXPECT_LE(deadline.GetHardDeadline(), qint64(120000));
+    EXPECT_GT(deadline.GetClientLatency(clients[50]), qint64(5000));
+    EXPECT_EQ(qint64(0), deadline.GetClientLatency(clients[0]));
+
+    EXPECT_EQ(10, deadline.GetPhaseCount());
+    EXPECT_EQ(qint64(20000), deadline.GetLastPhaseDuration());
+    EXPECT_EQ(3, deadline.GetLastExcluded());
+    EXPECT_EQ(15, deadline.GetTotalExcluded());
+  }
+
+  TEST(SubmissionDeadline, Excluded)
+  {
+    SubmissionDeadline deadline(1000, 120000, .9, 2.0, .5);
+    QList<Id> clients;
+    for(int idx = 0; idx < 10; idx++) {
+      clients.append(Id());
+    }
+
+    // Half of the clients miss every deadline, the estimate must not fall
+    // below the slowest client that made it nor grow with the deadline
+    qint64 hard = deadline.GetHardDeadline();
+    for(int phase = 0; phase < 10; phase++) {
+      for(int idx = 0; idx < 5; idx++) {
+        deadline.AddArrival(clients[idx], 100 + 100 * idx);
+      }
+      deadline.PhaseFinished(hard, clients.mid(5), hard);
+      hard = deadline.GetHardDeadline();
+    }
+
+    EXPECT_GE(deadline.GetPercentile(.9), qint64(500));
+    EXPECT_LE(deadline.GetPercentile(.9), qint64(600));
+    EXPECT_EQ(deadline.GetPercentile(.9), deadline.GetPercentile(.6));
+    EXPECT_LE(hard, qint64(1200));
+    EXPECT_GE(deadline.GetClientLatency(clients[9]), qint64(1000));
+    EXPECT_EQ(5, deadline.GetLastExcluded());
+    EXPECT_EQ(50, deadline.GetTotalExcluded());
+  }
+
+  TEST(SubmissionDeadline, RepeatedExclusion)
+  {
+    SubmissionDeadline deadline(1000, 120000);
+    QList<Id> clients;
+    for(int idx = 0; idx < 50; idx++) {
+      clients.append(Id());
+    }
+
+    // The same offline client is excluded phase after phase, its deadline
+    // must not be fed back into the next one
+    QList<Id> offline = clients.mid(49);
+    qint64 hard = deadline.GetHardDeadline();
+    EXPECT_EQ(qint64(120000), hard);
+    for(int phase = 0; phase < 20; phase++) {
+      for(int idx = 0; idx < 49; idx++) {
+        deadline.AddArrival(clients[idx], 2000 + 10 * idx);
+      }
+      deadline.PhaseFinished(hard, offline, hard);
+      hard = deadline.GetHardDeadline();
+      EXPECT_GE(hard, qint64(2 * 2480));
+      EXPECT_LE(hard, qint64(2 * 2 * 2480));
+    }
+    EXPECT_EQ(20, deadline.GetTotalExcluded());
+  }
+
+  TEST(SubmissionDeadline, RetainClients)
+  {
+    SubmissionDeadline deadline(1000, 120000);
+    Id stays, leaves;
+    deadline.AddArrival(stays, 100);
+    deadline.AddArrival(leaves, 200);
+    deadline.PhaseFinished(200, QList<Id>(), 1000);
+
+    QSet<Id> roster;
+    roster.insert(stays);
+    deadline.RetainClients(roster);
+    EXPECT_EQ(qint64(100), deadline.GetClientLatency(stays));
+    EXPECT_EQ(qint64(-1), deadline.GetClientLatency(leaves));
+    // History is about the phase, not the roster
+    EXPECT_GE(deadline.GetPercentile(.99), qint64(200));
+  }
+
+  TEST(SubmissionDeadline, Bounds)
+  {
+    SubmissionDeadline deadline(1000, 5000);
+    Id client;
+    deadline.AddArrival(client, 1);
+    deadline.PhaseFinished(1, QList<Id>(), 1);
+    EXPECT_EQ(qint64(1000), deadline.GetHardDeadline());
+
+    deadline.AddArrival(client, 1000000);
+    deadline.AddArrival(client, 1000000);
+    EXPECT_EQ(qint64(5000), deadline.GetHardDeadline());
+  }
+}
+}
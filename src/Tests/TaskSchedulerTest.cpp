@@ -0,0 +1,204 @@
+#include <QSemaphore>
+
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  /**
+   * Blocks its thread until the gate is opened
+   */
+  class GateTask : public QRunnable {
+    public:
+      GateTask(QSemaphore &started, QSemaphore &gate) :
+        _started(started), _gate(gate)
+      {
+      }
+
+      virtual void run()
+      {
+        _started.release();
+        _gate.acquire();
+      }
+
+    private:
+      QSemaphore &_started;
+      QSemaphore &_gate;
+  };
+
+  /**
+   * Records the order tasks ran in
+   */
+  class OrderTask : public QRunnable {
+    public:
+      OrderTask(int id, QList<int> &order, QMutex &lock) :
+        _id(id), _order(order), _lock(lock)
+      {
+      }
+
+      virtual void run()
+      {
+        QMutexLocker locker(&_lock);
+        _order.append(_id);
+      }
+
+    private:
+      int _id;
+      QList<int> &_order;
+      QMutex &_lock;
+  };
+
+  /**
+   * Counts how often each index is processed and which range covered it
+   */
+  class CountJob : public TaskScheduler::Job {
+    public:
+      CountJob(QVector<int> &counts, QVector<int> &ranges) :
+        _counts(counts.data()), _ranges(ranges.data())
+      {
+      }
+
+      virtual void Process(int start, int end, int range)
+      {
+        for(int idx = start; idx < end; idx++) {
+          _counts[idx]++;
+          _ranges[idx] = range;
+        }
+      }
+
+    private:
+      int *_counts;
+      int *_ranges;
+  };
+
+  TEST(TaskScheduler, Priority)
+  {
+    TaskScheduler scheduler(1);
+    QSemaphore started, gate;
+    scheduler.Start(new GateTask(started, gate), TaskScheduler::Critical);
+    started.acquire();
+
+    QList<int> order;
+    QMutex lock;
+    scheduler.Start(new OrderTask(TaskScheduler::Background, order, lock),
+        TaskScheduler::Background);
+    scheduler.Start(new OrderTask(TaskScheduler::Normal, order, lock),
+        TaskScheduler::Normal);
+    scheduler.Start(new OrderTask(TaskScheduler::Critical, order, lock),
+        TaskScheduler::Critical);
+
+    gate.release();
+    scheduler.WaitForDone();
+
+    ASSERT_EQ(order.count(), 3);
+    EXPECT_EQ(order[0], int(TaskScheduler::Critical));
+    EXPECT_EQ(order[1], int(TaskScheduler::Normal));
+    EXPECT_EQ(order[2], int(TaskScheduler::Background));
+    EXPECT_EQ(scheduler.GetStats().completed, 4);
+    EXPECT_EQ(scheduler.GetStats().cancelled, 0);
+  }
+
+  TEST(TaskScheduler, CancelGroup)
+  {
+    TaskScheduler scheduler(1);
+    QSemaphore started, gate;
+    QSharedPointer<TaskGroup> group(new TaskGroup("Test"));
+    scheduler.Start(new GateTask(started, gate), TaskScheduler::Normal, group);
+    started.acquire();
+
+    QList<int> order;
+    QMutex lock;
+    for(int idx = 0; idx < 5; idx++) {
+      scheduler.Start(new OrderTask(idx, order, lock),
+          TaskScheduler::Normal, group);
+    }
+    scheduler.Start(new OrderTask(5, order, lock));
+    EXPECT_EQ(group->GetPending(), 6);
+
+    group->Cancel();
+    EXPECT_TRUE(group->IsCancelled());
+    gate.release();
+    scheduler.WaitForDone();
+
+    ASSERT_EQ(order.count(), 1);
+    EXPECT_EQ(order[0], 5);
+    EXPECT_EQ(group->GetPending(), 0);
+    EXPECT_EQ(group->GetStats().completed, 1);
+    EXPECT_EQ(group->GetStats().cancelled, 5);
+    EXPECT_EQ(scheduler.GetStats().completed, 2);
+    EXPECT_EQ(scheduler.GetStats().cancelled, 5);
+  }
+
+  TEST(TaskScheduler, Timing)
+  {
+    TaskScheduler scheduler(1);
+    QSemaphore started, gate;
+    QSharedPointer<TaskGroup> group(new TaskGroup());
+    scheduler.Start(new GateTask(started, gate), TaskScheduler::Normal, group);
+    started.acquire();
+
+    QList<int> order;
+    QMutex lock;
+    scheduler.Start(new OrderTask(0, order, lock),
+        TaskScheduler::Normal, group);
+
+    Sleeper::MSleep(10);
+    gate.release();
+    scheduler.WaitForDone();
+
+    TaskStats stats = group->GetStats();
+    EXPECT_EQ(stats.completed, 2);
+    EXPECT_GE(stats.run_nsecs, qint64(10000000));
+    EXPECT_GE(stats.max_wait_nsecs, qint64(10000000));
+    EXPECT_GE(stats.wait_nsecs, stats.max_wait_nsecs);
+  }
+
+  TEST(TaskScheduler, KeepOwnership)
+  {
+    TaskScheduler scheduler(2);
+    QList<int> order;
+    QMutex lock;
+    OrderTask task(0, order, lock);
+    task.setAutoDelete(false);
+    scheduler.Start(&task);
+    scheduler.WaitForDone();
+    EXPECT_EQ(order.count(), 1);
+  }
+  TEST(TaskScheduler, ParallelFor)
+  {
+    TaskScheduler scheduler(4);
+    QVector<int> counts(10, 0);
+    QVector<int> ranges(10, -1);
+    CountJob job(counts, ranges);
+    scheduler.ParallelFor(counts.count(), job, TaskScheduler::Critical);
+
+    for(int idx = 0; idx < counts.count(); idx++) {
+      EXPECT_EQ(counts[idx], 1);
+    }
+
+    // Ranges are contiguous and the calling thread's comes first
+    EXPECT_EQ(ranges.first(), 0);
+    EXPECT_EQ(ranges.last(), 3);
+    for(int idx = 1; idx < ranges.count(); idx++) {
+      EXPECT_LE(ranges[idx - 1], ranges[idx]);
+    }
+
+    // Fewer indexes than ranges, and a single range, run inline
+    QVector<int> small_counts(2, 0);
+    QVector<int> small_ranges(2, -1);
+    CountJob small(small_counts, small_ranges);
+    scheduler.ParallelFor(small_counts.count(), small, TaskScheduler::Normal,
+        8);
+    EXPECT_EQ(small_counts[0], 1);
+    EXPECT_EQ(small_counts[1], 1);
+    EXPECT_EQ(small_ranges[1], 1);
+
+    scheduler.ParallelFor(small_counts.count(), small, TaskScheduler::Normal,
+        1);
+    EXPECT_EQ(small_counts[0], 2);
+    EXPECT_EQ(small_counts[1], 2);
+    EXPECT_EQ(small_ranges[1], 0);
+
+    scheduler.ParallelFor(0, small);
+  }
+}
+}
@@ -0,0 +1,173 @@
+#include <QElapsedTimer>
+
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  QList<XorKernel::Variant> SupportedVariants()
+  {
+    QList<XorKernel::Variant> variants;
+    variants << XorKernel::Bytewise << XorKernel::Word <<
+      XorKernel::Sse2 << XorKernel::Avx2;
+
+    QList<XorKernel::Variant> supported;
+    foreach(XorKernel::Variant variant, variants) {
+      if(XorKernel::Supported(variant)) {
+        supported.append(variant);
+      }
+    }
+    return supported;
+  }
+
+  QByteArray SlowXor(const QByteArray &t1, const QByteArray &t2)
+  {
+    QByteArray out(std::min(t1.size(), t2.size()), 0);
+    for(int idx = 0; idx < out.size(); idx++) {
+      out[idx] = t1[idx] ^ t2[idx];
+    }
+    return out;
+  }
+
+  TEST(XorKernel, Variants)
+  {
+    XorKernel::Variant best = XorKernel::GetVariant();
+    EXPECT_TRUE(XorKernel::Supported(best));
+    EXPECT_TRUE(XorKernel::Supported(XorKernel::Bytewise));
+    EXPECT_TRUE(XorKernel::Supported(XorKernel::Word));
+
+    CppRandom rand;
+    foreach(XorKernel::Variant variant, SupportedVariants()) {
+      XorKernel::SetVariant(variant);
+      EXPECT_EQ(variant, XorKernel::GetVariant());
+
+      // Exercise the unaligned heads and tails of every block width
+      for(int length = 0; length < 300; length++) {
+        for(int offset = 0; offset < 4; offset++) {
+          QByteArray t1(length + offset, 0);
+          QByteArray t2(length + offset, 0);
+          rand.GenerateBlock(t1);
+          rand.GenerateBlock(t2);
+
+          QByteArray expected = SlowXor(t1, t2);
+          QByteArray dst = t1;
+          XorKernel::XorInPlace(dst.data() + offset, t2.constData() + offset,
+              length);
+          EXPECT_EQ(expected.mid(offset), dst.mid(offset));
+          EXPECT_EQ(t1.left(offset), dst.left(offset));
+        }
+      }
+    }
+
+    XorKernel::SetVariant(best);
+  }
+
+  TEST(XorKernel, ByteArrays)
+  {
+    CppRandom rand;
+    QByteArray t1(1000, 0);
+    QByteArray t2(1000, 0);
+    rand.GenerateBlock(t1);
+    rand.GenerateBlock(t2);
+
+    QByteArray dst(1000, 0);
+    XorKernel::Xor(dst, t1, t2);
+    EXPECT_EQ(SlowXor(t1, t2), dst);
+
+    // Implicitly shared data should not be modified
+    QByteArray t1_copy = t1;
+    QByteArray shared = t1;
+    XorKernel::XorInPlace(shared, t2);
+    EXPECT_EQ(dst, shared);
+    EXPECT_EQ(t1_copy, t1);
+
+    // Aliased destinations
+    QByteArray aliased = t1;
+    XorKernel::Xor(aliased, aliased, t2);
+    EXPECT_EQ(dst, aliased);
+    XorKernel::Xor(aliased, t2, aliased);
+    EXPECT_EQ(t1, aliased);
+
+    // Shorter inputs only cover their own length
+    QByteArray small = t2.left(10);
+    QByteArray partial = t1;
+    XorKernel::XorInPlace(partial, small);
+    EXPECT_EQ(dst.left(10), partial.left(10));
+    EXPECT_EQ(t1.mid(10), partial.mid(10));
+
+    QByteArray empty;
+    XorKernel::XorInPlace(empty, t1);
+    EXPECT_TRUE(empty.isEmpty());
+  }
+
+  TEST(XorKernel, XorMany)
+  {
+    CppRandom rand;
+    int length = 3 * XorKernel::CHUNK_SIZE + 17;
+
+    QByteArray expected(length, 0);
+    QList<QByteArray> srcs;
+    for(int idx = 0; idx < 10; idx++) {
+      QByteArray src(length, 0);
+      rand.GenerateBlock(src);
+      expected = SlowXor(expected, src);
+      srcs.append(src);
+    }
+
+    QByteArray short_src(100, 0);
+    rand.GenerateBlock(short_src);
+    srcs.append(short_src);
+    expected.replace(0, 100, SlowXor(expected, short_src));
+
+    QByteArray dst(length, 0);
+    XorKernel::XorMany(dst, srcs);
+    EXPECT_EQ(expected, dst);
+
+    // Operates on the existing contents of dst
+    XorKernel::XorMany(dst, srcs);
+    EXPECT_EQ(QByteArray(length, 0), dst);
+  }
+
+  TEST(XorKernel, DISABLED_Benchmark)
+  {
+    XorKernel::Variant best = XorKernel::GetVariant();
+    QList<int> sizes;
+    sizes << 1024 << 64 * 1024 << 1024 * 1024;
+
+    foreach(int size, sizes) {
+      QByteArray dst(size, 0);
+      QList<QByteArray> srcs;
+      for(int idx = 0; idx < 8; idx++) {
+        srcs.append(QByteArray(size, char(idx)));
+      }
+
+      qint64 bytes = 64 * 1024 * 1024;
+      int iterations = std::max(1, int(bytes / size));
+
+      foreach(XorKernel::Variant variant, SupportedVariants()) {
+        XorKernel::SetVariant(variant);
+        QElapsedTimer timer;
+
+        timer.start();
+        for(int idx = 0; idx < iterations; idx++) {
+          XorKernel::XorInPlace(dst, srcs[idx % srcs.count()]);
+        }
+        qint64 in_place = std::max(timer.nsecsElapsed(), qint64(1));
+
+        timer.start();
+        for(int idx = 0; idx < iterations; idx += srcs.count()) {
+          XorKernel::XorMany(dst, srcs);
+        }
+        qint64 many = std::max(timer.nsecsElapsed(), qint64(1));
+
+        double processed = double(iterations) * size;
+        qDebug() << "!BENCHMARK!" << "XorKernel" <<
+          XorKernel::VariantToString(variant) << "| size:" << size <<
+          "| in place GB/s:" << processed / in_place <<
+          "| many GB/s:" << processed / many;
+      }
+    }
+
+    XorKernel::SetVariant(best);
+  }
+}
+}
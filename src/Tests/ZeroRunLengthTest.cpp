@@ -0,0 +1,77 @@
+#include "DissentTest.hpp"
+
+namespace Dissent {
+namespace Tests {
+  TEST(ZeroRunLength, RoundTrip)
+  {
+    CppRandom rand;
+    for(int count = 0; count < 200; count++) {
+      int size = rand.GetInt(0, 5000);
+      int density = rand.GetInt(0, 101);
+
+      QByteArray data(size, 0);
+      for(int idx = 0; idx < size; idx++) {
+        if(rand.GetInt(0, 100) < density) {
+          data[idx] = char(rand.GetInt(1, 256));
+        }
+      }
+
+      QByteArray encoded = ZeroRunLength::Encode(data);
+      QByteArray decoded;
+      EXPECT_TRUE(ZeroRunLength::Decode(encoded, decoded, size));
+      EXPECT_EQ(data, decoded);
+
+      // Dense data only carries a few bytes of overhead
+      EXPECT_LE(encoded.size(), size + 16 + size / 128);
+    }
+  }
+
+  TEST(ZeroRunLength, Sparse)
+  {
+    QByteArray data(100000, 0);
+    data[10] = 1;
+    data[50000] = 2;
+    data[50002] = 3;
+    data[99999] = 4;
+
+    QByteArray encoded = ZeroRunLength::Encode(data);
+    EXPECT_LT(encoded.size(), 32);
+
+    QByteArray decoded;
+    EXPECT_TRUE(ZeroRunLength::Decode(encoded, decoded, data.size()));
+    EXPECT_EQ(data, decoded);
+
+    QByteArray empty;
+    EXPECT_TRUE(ZeroRunLength::Decode(ZeroRunLength::Encode(empty), decoded, 0));
+    EXPECT_TRUE(decoded.isEmpty());
+  }
+
+  TEST(ZeroRunLength, Malformed)
+  {
+    CppRandom rand;
+    QByteArray data(1000, 0);
+    for(int idx = 0; idx < data.size(); idx += 7) {
+      data[idx] = char(idx | 1);
+    }
+    QByteArray encoded = ZeroRunLength::Encode(data);
+    QByteArray decoded;
+
+    // Too large
+    EXPECT_FALSE(ZeroRunLength::Decode(encoded, decoded, data.size() - 1));
+
+    // Truncated
+    EXPECT_FALSE(ZeroRunLength::Decode(encoded.left(encoded.size() - 1),
+          decoded, data.size()));
+    EXPECT_FALSE(ZeroRunLength::Decode(QByteArray(), decoded, data.size()));
+
+    // Random garbage never decodes past the limit
+    for(int count = 0; count < 100; count++) {
+      QByteArray garbage(rand.GetInt(1, 100), 0);
+      rand.GenerateBlock(garbage);
+      if(ZeroRunLength::Decode(garbage, decoded, 1000)) {
+        EXPECT_LE(decoded.size(), 1000);
+      }
+    }
+  }
+}
+}
@@ -56,6 +56,11 @@ namespace Utils {
        */
       inline void IncrementByteCount(uint count) { _byte_count+= count; }
 
+      /**
+       * Sets the amount of bytes generated thus far, used by seekable rngs.
+       */
+      inline void SetByteCount(uint count) { _byte_count = count; }
+
       /**
        * Moves the rng to specified position
        * @param index the position
@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QThread>
+
+#include "TaskScheduler.hpp"
+
+namespace Dissent {
+namespace Utils {
+  /**
+   * Wraps a task to skip it when its group is cancelled and to time it
+   */
+  class ScheduledTask : public QRunnable {
+    public:
+      ScheduledTask(TaskScheduler &scheduler, QRunnable *task,
+          const QSharedPointer<TaskGroup> &group) :
+        _scheduler(scheduler), _task(task), _group(group)
+      {
+        _queued.start();
+      }
+
+      virtual void run()
+      {
+        qint64 wait = _queued.nsecsElapsed();
+        qint64 run = 0;
+        bool skipped = _group && _group->IsCancelled();
+
+        if(!skipped) {
+          QElapsedTimer timer;
+          timer.start();
+          _task->run();
+          run = timer.nsecsElapsed();
+        }
+
+        if(_task->autoDelete()) {
+          delete _task;
+        }
+
+        if(_group) {
+          _group->TaskFinished(skipped, wait, run);
+        }
+        _scheduler.TaskFinished(skipped, wait, run);
+      }
+
+    private:
+      TaskScheduler &_scheduler;
+      QRunnable *_task;
+      QSharedPointer<TaskGroup> _group;
+      QElapsedTimer _queued;
+  };
+
+namespace {
+  /**
+   * Processes one range of a ParallelFor job
+   */
+  class RangeTask : public QRunnable {
+    public:
+      RangeTask(TaskScheduler::Job &job, int start, int end, int range,
+          QSemaphore &done) :
+        _job(job), _start(start), _end(end), _range(range), _done(done)
+      {
+      }
+
+      virtual void run()
+      {
+        _job.Process(_start, _end, _range);
+        _done.release();
+      }
+
+    private:
+      TaskScheduler::Job &_job;
+      int _start;
+      int _end;
+      int _range;
+      QSemaphore &_done;
+  };
+}
+
+  void TaskStats::Add(bool skipped, qint64 wait, qint64 run)
+  {
+    if(skipped) {
+      cancelled++;
+    } else {
+      completed++;
+    }
+    run_nsecs += run;
+    wait_nsecs += wait;
+    max_wait_nsecs = std::max(max_wait_nsecs, wait);
+  }
+
+  QDebug operator<<(QDebug dbg, const TaskStats &stats)
+  {
+    dbg.nospace() << "completed: " << stats.completed << ", cancelled: " <<
+      stats.cancelled << ", run (ms): " << stats.run_nsecs / 1000000 <<
+      ", queued (ms): " << stats.wait_nsecs / 1000000 <<
+      ", max queued (ms): " << stats.max_wait_nsecs / 1000000;
+    return dbg.space();
+  }
+
+  TaskGroup::TaskGroup(const QString &name) :
+    _name(name),
+    _cancelled(0),
+    _pending(0)
+  {
+  }
+
+  void TaskGroup::Cancel()
+  {
+    _cancelled.fetchAndStoreOrdered(1);
+  }
+
+  TaskStats TaskGroup::GetStats() const
+  {
+    QMutexLocker locker(&_lock);
+    return _stats;
+  }
+
+  void TaskGroup::TaskQueued()
+  {
+    _pending.ref();
+  }
+
+  void TaskGroup::TaskFinished(bool skipped, qint64 wait, qint64 run)
+  {
+    {
+      QMutexLocker locker(&_lock);
+      _stats.Add(skipped, wait, run);
+    }
+    _pending.deref();
+  }
+
+  TaskScheduler &TaskScheduler::GetInstance()
+  {
+    static TaskScheduler scheduler;
+    return scheduler;
+  }
+
+  TaskScheduler::TaskScheduler(int threads) :
+    _pool(new QThreadPool())
+  {
+    SetThreadCount(threads);
+  }
+
+  TaskScheduler::~TaskScheduler()
+  {
+    _pool->waitForDone();
+  }
+
+  void TaskScheduler::Start(QRunnable *task, Priority priority,
+      const QSharedPointer<TaskGroup> &group)
+  {
+    if(group) {
+      group->TaskQueued();
+    }
+    _pool->start(new ScheduledTask(*this, task, group), priority);
+  }
+
+  void TaskScheduler::ParallelFor(int count, Job &job, Priority priority,
+      int ranges)
+  {
+    if(count <= 0) {
+      return;
+    }
+
+    if(ranges <= 0) {
+      ranges = GetThreadCount();
+    }
+    ranges = std::min(ranges, count);
+
+    if(ranges <= 1) {
+      job.Process(0, count, 0);
+      return;
+    }
+
+    QSemaphore done;
+    int per_range = count / ranges;
+    int extra = count % ranges;
+    int first_end = per_range + (extra > 0 ? 1 : 0);
+    int start = first_end;
+
+    for(int idx = 1; idx < ranges; idx++) {
+      int end = start + per_range + (idx < extra ? 1 : 0);
+      Start(new RangeTask(job, start, end, idx, done), priority);
+      start = end;
+    }
+
+    job.Process(0, first_end, 0);
+    done.acquire(ranges - 1);
+  }
+
+  void TaskScheduler::SetThreadCount(int threads)
+  {
+    if(threads < 0) {
+      qCritical() << "Invalid thread count:" << threads;
+      threads = 1;
+    } else if(threads == 0) {
+      threads = qMax(1, QThread::idealThreadCount());
+    }
+    _pool->setMaxThreadCount(threads);
+  }
+
+  void TaskScheduler::WaitForDone()
+  {
+    _pool->waitForDone();
+  }
+
+  TaskStats TaskScheduler::GetStats() const
+  {
+    QMutexLocker locker(&_lock);
+    return _stats;
+  }
+
+  void TaskScheduler::TaskFinished(bool skipped, qint64 wait, qint64 run)
+  {
+    QMutexLocker locker(&_lock);
+    _stats.Add(skipped, wait, run);
+  }
+}
+}
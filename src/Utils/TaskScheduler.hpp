@@ -0,0 +1,214 @@
+#ifndef DISSENT_UTILS_TASK_SCHEDULER_H_GUARD
+#define DISSENT_UTILS_TASK_SCHEDULER_H_GUARD
+
+#include <QAtomicInt>
+#include <QDebug>
+#include <QMutex>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QThreadPool>
+
+namespace Dissent {
+namespace Utils {
+  /**
+   * Timing of the tasks run by a TaskScheduler or within a TaskGroup
+   */
+  class TaskStats {
+    public:
+      TaskStats() :
+        completed(0),
+        cancelled(0),
+        run_nsecs(0),
+        wait_nsecs(0),
+        max_wait_nsecs(0)
+      {
+      }
+
+      /**
+       * Accounts for a finished task
+       * @param skipped true if the task was cancelled before it ran
+       * @param wait nanoseconds the task spent queued
+       * @param run nanoseconds the task spent running
+       */
+      void Add(bool skipped, qint64 wait, qint64 run);
+
+      int completed;
+      int cancelled;
+      qint64 run_nsecs;
+      qint64 wait_nsecs;
+      qint64 max_wait_nsecs;
+  };
+
+  QDebug operator<<(QDebug dbg, const TaskStats &stats);
+
+  /**
+   * A set of tasks belonging to the same owner, such as a round, that may be
+   * cancelled together.  Tasks of a cancelled group that have not started
+   * are dropped, running tasks may poll IsCancelled to stop early.  Since a
+   * grouped task may never run, nothing should block waiting on one;
+   * fork-join work the caller waits on is started without a group.
+   */
+  class TaskGroup {
+    public:
+      /**
+       * Constructor
+       * @param name used when logging the group
+       */
+      explicit TaskGroup(const QString &name = QString());
+
+      /**
+       * Drops any task of the group not yet started
+       */
+      void Cancel();
+
+      /**
+       * Returns true if the group has been cancelled
+       */
+      inline bool IsCancelled() const { return _cancelled != 0; }
+
+      /**
+       * Returns the amount of tasks started but not yet finished
+       */
+      inline int GetPending() const { return _pending; }
+
+      /**
+       * Returns the timing of the group's finished tasks
+       */
+      TaskStats GetStats() const;
+
+      /**
+       * Returns the name of the group
+       */
+      inline QString GetName() const { return _name; }
+
+    private:
+      friend class TaskScheduler;
+      friend class ScheduledTask;
+      void TaskQueued();
+      void TaskFinished(bool skipped, qint64 wait, qint64 run);
+
+      QString _name;
+      QAtomicInt _cancelled;
+      QAtomicInt _pending;
+      mutable QMutex _lock;
+      TaskStats _stats;
+  };
+
+  /**
+   * Runs tasks on a pool of threads in priority order, optionally as part
+   * of a cancellable TaskGroup, and keeps the time tasks spend queued and
+   * running.  The shared instance carries the CryptoFactory's work, others
+   * may be created for work that should not compete with it.
+   */
+  class TaskScheduler {
+    public:
+      /**
+       * Tasks of a higher priority are started before those of a lower
+       */
+      enum Priority {
+        /**
+         * Work for the future, such as precomputation
+         */
+        Background = 0,
+        /**
+         * Work a round is waiting on
+         */
+        Normal,
+        /**
+         * Verification and other work on the critical path of every member
+         */
+        Critical
+      };
+
+      /**
+       * Data parallel work for ParallelFor, split into contiguous ranges
+       */
+      class Job {
+        public:
+          virtual ~Job() {}
+
+          /**
+           * Processes the indexes [start, end), called concurrently for
+           * disjoint ranges
+           * @param start the first index
+           * @param end one past the last index
+           * @param range which range this is, 0 runs on the calling thread
+           */
+          virtual void Process(int start, int end, int range) = 0;
+      };
+
+      /**
+       * Returns the shared scheduler
+       */
+      static TaskScheduler &GetInstance();
+
+      /**
+       * Constructor
+       * @param threads the amount of threads, 0 uses one per core
+       */
+      explicit TaskScheduler(int threads = 0);
+
+      /**
+       * Destructor, waits for all tasks
+       */
+      ~TaskScheduler();
+
+      /**
+       * Queues a task, taking ownership of it if its autoDelete is set
+       * @param task the task to run
+       * @param priority the task's priority
+       * @param group optional group the task belongs to
+       */
+      void Start(QRunnable *task, Priority priority = Normal,
+          const QSharedPointer<TaskGroup> &group = QSharedPointer<TaskGroup>());
+
+      /**
+       * Splits [0, count) into at most ranges contiguous ranges, the calling
+       * thread processes the first and the pool the rest.  Returns once
+       * every range has been processed.  The ranges are started without a
+       * group, so none can be dropped while the caller waits.
+       * @param count the amount of indexes
+       * @param job the work to run
+       * @param priority the priority of the scheduled ranges
+       * @param ranges the most ranges to use, 0 uses one per thread
+       */
+      void ParallelFor(int count, Job &job, Priority priority = Normal,
+          int ranges = 0);
+
+      /**
+       * Sets the amount of threads
+       * @param threads the amount of threads, 0 uses one per core
+       */
+      void SetThreadCount(int threads);
+
+      /**
+       * Returns the amount of threads
+       */
+      inline int GetThreadCount() const { return _pool->maxThreadCount(); }
+
+      /**
+       * Waits for every queued and running task to finish
+       */
+      void WaitForDone();
+
+      /**
+       * Returns the timing of all finished tasks
+       */
+      TaskStats GetStats() const;
+
+    private:
+      friend class ScheduledTask;
+      void TaskFinished(bool skipped, qint64 wait, qint64 run);
+
+      QScopedPointer<QThreadPool> _pool;
+      mutable QMutex _lock;
+      TaskStats _stats;
+
+      Q_DISABLE_COPY(TaskScheduler)
+  };
+}
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include <QDebug>
 
 #include "Sleeper.hpp"
+#include "TaskScheduler.hpp"
 #include "Timer.hpp"
 
 namespace Dissent {
@@ -126,9 +127,8 @@ namespace Utils {
     }
 
     qint64 next = Run();
-    // @TODO make Utils::ThreadPool that for virtual clock runs the task
-    // inline as opposed to another thread
-    QThreadPool::globalInstance()->waitForDone();
+    // Let crypto work spawned by the events finish before time moves on
+    TaskScheduler::GetInstance().WaitForDone();
 
     QCoreApplication::processEvents();
     QCoreApplication::sendPostedEvents();
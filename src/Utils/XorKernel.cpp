@@ -0,0 +1,284 @@
+#include <string.h>
+#include <algorithm>
+#include <QtGlobal>
+#include <QVector>
+
+#include "XorKernel.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISSENT_XOR_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+namespace Dissent {
+namespace Utils {
+namespace {
+  typedef void (*XorFunction)(char *, const char *, const char *, int);
+
+  void BytewiseXor(char *dst, const char *src0, const char *src1, int length)
+  {
+    for(int idx = 0; idx < length; idx++) {
+      dst[idx] = src0[idx] ^ src1[idx];
+    }
+  }
+
+  void WordXor(char *dst, const char *src0, const char *src1, int length)
+  {
+    int idx = 0;
+    // Align the destination, then the loop is aligned stores and (possibly)
+    // unaligned loads, memcpy keeps this well defined and compiles to a mov
+    while(idx < length && (reinterpret_cast<quintptr>(dst + idx) & 7)) {
+      dst[idx] = src0[idx] ^ src1[idx];
+      idx++;
+    }
+
+    for(; idx + 8 <= length; idx += 8) {
+      quint64 a, b;
+      memcpy(&a, src0 + idx, 8);
+      memcpy(&b, src1 + idx, 8);
+      a ^= b;
+      memcpy(dst + idx, &a, 8);
+    }
+
+    BytewiseXor(dst + idx, src0 + idx, src1 + idx, length - idx);
+  }
+
+#ifdef DISSENT_XOR_X86
+  __attribute__((target("sse2")))
+  void Sse2Xor(char *dst, const char *src0, const char *src1, int length)
+  {
+    int idx = 0;
+    while(idx < length && (reinterpret_cast<quintptr>(dst + idx) & 15)) {
+      dst[idx] = src0[idx] ^ src1[idx];
+      idx++;
+    }
+
+    for(; idx + 64 <= length; idx += 64) {
+      const __m128i *a = reinterpret_cast<const __m128i *>(src0 + idx);
+      const __m128i *b = reinterpret_cast<const __m128i *>(src1 + idx);
+      __m128i *d = reinterpret_cast<__m128i *>(dst + idx);
+      __m128i r0 = _mm_xor_si128(_mm_loadu_si128(a), _mm_loadu_si128(b));
+      __m128i r1 = _mm_xor_si128(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1));
+      __m128i r2 = _mm_xor_si128(_mm_loadu_si128(a + 2), _mm_loadu_si128(b + 2));
+      __m128i r3 = _mm_xor_si128(_mm_loadu_si128(a + 3), _mm_loadu_si128(b + 3));
+      _mm_store_si128(d, r0);
+      _mm_store_si128(d + 1, r1);
+      _mm_store_si128(d + 2, r2);
+      _mm_store_si128(d + 3, r3);
+    }
+
+    for(; idx + 16 <= length; idx += 16) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + idx));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + idx));
+      _mm_store_si128(reinterpret_cast<__m128i *>(dst + idx), _mm_xor_si128(a, b));
+    }
+
+    BytewiseXor(dst + idx, src0 + idx, src1 + idx, length - idx);
+  }
+
+  __attribute__((target("avx2")))
+  void Avx2Xor(char *dst, const char *src0, const char *src1, int length)
+  {
+    int idx = 0;
+    while(idx < length && (reinterpret_cast<quintptr>(dst + idx) & 31)) {
+      dst[idx] = src0[idx] ^ src1[idx];
+      idx++;
+    }
+
+    for(; idx + 128 <= length; idx += 128) {
+      const __m256i *a = reinterpret_cast<const __m256i *>(src0 + idx);
+      const __m256i *b = reinterpret_cast<const __m256i *>(src1 + idx);
+      __m256i *d = reinterpret_cast<__m256i *>(dst + idx);
+      __m256i r0 = _mm256_xor_si256(_mm256_loadu_si256(a), _mm256_loadu_si256(b));
+      __m256i r1 = _mm256_xor_si256(_mm256_loadu_si256(a + 1), _mm256_loadu_si256(b + 1));
+      __m256i r2 = _mm256_xor_si256(_mm256_loadu_si256(a + 2), _mm256_loadu_si256(b + 2));
+      __m256i r3 = _mm256_xor_si256(_mm256_loadu_si256(a + 3), _mm256_loadu_si256(b + 3));
+      _mm256_store_si256(d, r0);
+      _mm256_store_si256(d + 1, r1);
+      _mm256_store_si256(d + 2, r2);
+      _mm256_store_si256(d + 3, r3);
+    }
+
+    for(; idx + 32 <= length; idx += 32) {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src0 + idx));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src1 + idx));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(dst + idx), _mm256_xor_si256(a, b));
+    }
+
+    BytewiseXor(dst + idx, src0 + idx, src1 + idx, length - idx);
+  }
+#endif
+
+  XorFunction GetFunction(XorKernel::Variant variant)
+  {
+    switch(variant) {
+#ifdef DISSENT_XOR_X86
+      case XorKernel::Avx2:
+        return &Avx2Xor;
+      case XorKernel::Sse2:
+        return &Sse2Xor;
+#endif
+      case XorKernel::Bytewise:
+        return &BytewiseXor;
+      default:
+        return &WordXor;
+    }
+  }
+
+  struct Dispatch {
+    Dispatch() :
+      variant(XorKernel::BestVariant()),
+      function(GetFunction(variant))
+    {
+    }
+
+    XorKernel::Variant variant;
+    XorFunction function;
+  };
+
+  Dispatch &GetDispatch()
+  {
+    static Dispatch dispatch;
+    return dispatch;
+  }
+}
+
+  const int XorKernel::CHUNK_SIZE;
+
+  bool XorKernel::Supported(Variant variant)
+  {
+    switch(variant) {
+      case Bytewise:
+      case Word:
+        return true;
+#ifdef DISSENT_XOR_X86
+      case Sse2:
+        return __builtin_cpu_supports("sse2");
+      case Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+      default:
+        return false;
+    }
+  }
+
+  XorKernel::Variant XorKernel::BestVariant()
+  {
+    if(Supported(Avx2)) {
+      return Avx2;
+    } else if(Supported(Sse2)) {
+      return Sse2;
+    }
+    return Word;
+  }
+
+  QString XorKernel::VariantToString(Variant variant)
+  {
+    switch(variant) {
+      case Bytewise:
+        return "Bytewise";
+      case Word:
+        return "Word";
+      case Sse2:
+        return "SSE2";
+      case Avx2:
+        return "AVX2";
+      default:
+        return "Unknown";
+    }
+  }
+
+  XorKernel::Variant XorKernel::GetVariant()
+  {
+    return GetDispatch().variant;
+  }
+
+  void XorKernel::SetVariant(Variant variant)
+  {
+    if(!Supported(variant)) {
+      return;
+    }
+
+    Dispatch &dispatch = GetDispatch();
+    dispatch.variant = variant;
+    dispatch.function = GetFunction(variant);
+  }
+
+  void XorKernel::XorInPlace(char *dst, const char *src, int length)
+  {
+    GetDispatch().function(dst, dst, src, length);
+  }
+
+  void XorKernel::Xor(char *dst, const char *src0, const char *src1, int length)
+  {
+    GetDispatch().function(dst, src0, src1, length);
+  }
+
+  void XorKernel::XorMany(char *dst, const char * const *srcs, int count,
+      int length)
+  {
+    XorFunction function = GetDispatch().function;
+    for(int offset = 0; offset < length; offset += CHUNK_SIZE) {
+      int chunk = std::min(CHUNK_SIZE, length - offset);
+      for(int idx = 0; idx < count; idx++) {
+        function(dst + offset, dst + offset, srcs[idx] + offset, chunk);
+      }
+    }
+  }
+
+  void XorKernel::XorInPlace(QByteArray &dst, const QByteArray &src)
+  {
+    int count = std::min(dst.size(), src.size());
+    if(count == 0) {
+      return;
+    }
+    XorInPlace(dst.data(), src.constData(), count);
+  }
+
+  void XorKernel::Xor(QByteArray &dst, const QByteArray &t1, const QByteArray &t2)
+  {
+    int count = std::min(dst.size(), t1.size());
+    count = std::min(count, t2.size());
+    if(count == 0) {
+      return;
+    }
+
+    // Resolve the sources before detaching dst, since dst may share data
+    // with either source
+    const char *src0 = t1.constData();
+    const char *src1 = t2.constData();
+    char *out = dst.data();
+    if(&dst == &t1) {
+      src0 = out;
+    }
+    if(&dst == &t2) {
+      src1 = out;
+    }
+    Xor(out, src0, src1, count);
+  }
+
+  void XorKernel::XorMany(QByteArray &dst, const QList<QByteArray> &srcs)
+  {
+    if(dst.isEmpty()) {
+      return;
+    }
+
+    QVector<const char *> full;
+    full.reserve(srcs.count());
+    char *out = dst.data();
+
+    foreach(const QByteArray &src, srcs) {
+      if(src.size() >= dst.size()) {
+        full.append(src.constData());
+      } else {
+        XorInPlace(out, src.constData(), src.size());
+      }
+    }
+
+    if(!full.isEmpty()) {
+      XorMany(out, full.constData(), full.count(), dst.size());
+    }
+  }
+}
+}
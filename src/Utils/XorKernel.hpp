@@ -0,0 +1,124 @@
+#ifndef DISSENT_UTILS_XOR_KERNEL_H_GUARD
+#define DISSENT_UTILS_XOR_KERNEL_H_GUARD
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace Dissent {
+namespace Utils {
+  /**
+   * Provides the xor primitives used by every DC-net round.  Data is
+   * processed in aligned machine words or SIMD registers rather than a byte
+   * at a time.  On x86 the widest instruction set supported by the running
+   * processor (AVX2 or SSE2) is selected the first time the kernel is used,
+   * everywhere else a portable 64-bit word implementation is used.
+   */
+  class XorKernel {
+    public:
+      /**
+       * The available xor implementations
+       */
+      enum Variant {
+        Bytewise = 0,
+        Word,
+        Sse2,
+        Avx2
+      };
+
+      /**
+       * Returns the fastest variant supported by this processor
+       */
+      static Variant BestVariant();
+
+      /**
+       * Returns true if the variant can run on this processor
+       * @param variant the variant to check
+       */
+      static bool Supported(Variant variant);
+
+      /**
+       * Converts a Variant into a QString
+       * @param variant value to convert
+       */
+      static QString VariantToString(Variant variant);
+
+      /**
+       * Returns the variant currently used by the xor methods
+       */
+      static Variant GetVariant();
+
+      /**
+       * Overrides the variant used by the xor methods, mainly for testing and
+       * benchmarking.  Unsupported variants are ignored.
+       * @param variant the variant to use
+       */
+      static void SetVariant(Variant variant);
+
+      /**
+       * dst ^= src for length bytes
+       * @param dst the destination buffer
+       * @param src the source buffer
+       * @param length the amount of bytes to xor
+       */
+      static void XorInPlace(char *dst, const char *src, int length);
+
+      /**
+       * dst = src0 ^ src1 for length bytes, dst may alias either source
+       * @param dst the destination buffer
+       * @param src0 lhs of the xor operation
+       * @param src1 rhs of the xor operation
+       * @param length the amount of bytes to xor
+       */
+      static void Xor(char *dst, const char *src0, const char *src1, int length);
+
+      /**
+       * dst ^= srcs[0] ^ srcs[1] ^ ... for length bytes.  The sources are
+       * folded into the destination in cache sized chunks, so the destination
+       * is only streamed through memory once.
+       * @param dst the destination buffer
+       * @param srcs the source buffers
+       * @param count the number of source buffers
+       * @param length the amount of bytes to xor
+       */
+      static void XorMany(char *dst, const char * const *srcs, int count,
+          int length);
+
+      /**
+       * dst ^= src, over the shorter of the two arrays
+       * @param dst the destination byte array
+       * @param src the source byte array
+       */
+      static void XorInPlace(QByteArray &dst, const QByteArray &src);
+
+      /**
+       * dst = t1 ^ t2, over the shortest of the three arrays
+       * @param dst the destination byte array
+       * @param t1 lhs of the xor operation
+       * @param t2 rhs of the xor operation
+       */
+      static void Xor(QByteArray &dst, const QByteArray &t1, const QByteArray &t2);
+
+      /**
+       * dst ^= srcs[0] ^ srcs[1] ^ ..., each source covers the shorter of
+       * itself and dst
+       * @param dst the destination byte array
+       * @param srcs the source byte arrays
+       */
+      static void XorMany(QByteArray &dst, const QList<QByteArray> &srcs);
+
+      /**
+       * Size of the chunks used by XorMany
+       */
+      static const int CHUNK_SIZE = 8192;
+
+    private:
+      /**
+       * No instances of this class
+       */
+      XorKernel() {}
+  };
+}
+}
+
+#endif
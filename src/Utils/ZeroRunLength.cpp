@@ -0,0 +1,121 @@
+#include <string.h>
+
+#include "ZeroRunLength.hpp"
+
+namespace Dissent {
+namespace Utils {
+  void ZeroRunLength::WriteVarInt(quint32 value, QByteArray &data)
+  {
+    while(value >= 0x80) {
+      data.append(char((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    data.append(char(value));
+  }
+
+  bool ZeroRunLength::ReadVarInt(const QByteArray &data, int &offset,
+      quint32 &value)
+  {
+    value = 0;
+    for(int shift = 0; shift < 35; shift += 7) {
+      if(offset >= data.size()) {
+        return false;
+      }
+      quint32 byte = quint8(data[offset++]);
+      value |= (byte & 0x7F) << shift;
+      if(!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  QByteArray ZeroRunLength::Encode(const QByteArray &data)
+  {
+    const char *in = data.constData();
+    int size = data.size();
+
+    QByteArray encoded;
+    encoded.reserve(size / 4 + 16);
+    WriteVarInt(size, encoded);
+
+    int idx = 0;
+    while(idx < size) {
+      int zero_start = idx;
+      while(idx < size && in[idx] == 0) {
+        idx++;
+      }
+      int zeros = idx - zero_start;
+
+      // Extend the literal until a zero run worth encoding or the end
+      int literal_start = idx;
+      while(idx < size) {
+        if(in[idx] != 0) {
+          idx++;
+          continue;
+        }
+
+        int run = 0;
+        while(idx + run < size && in[idx + run] == 0 && run < MIN_RUN) {
+          run++;
+        }
+
+        if(run >= MIN_RUN || idx + run == size) {
+          break;
+        }
+        idx += run;
+      }
+
+      WriteVarInt(zeros, encoded);
+      WriteVarInt(idx - literal_start, encoded);
+      encoded.append(in + literal_start, idx - literal_start);
+    }
+
+    return encoded;
+  }
+
+  bool ZeroRunLength::Decode(const QByteArray &encoded, QByteArray &decoded,
+      int max_size)
+  {
+    int offset = 0;
+    quint32 size;
+    if(!ReadVarInt(encoded, offset, size) || size > quint32(max_size)) {
+      return false;
+    }
+
+    QByteArray output(int(size), 0);
+    char *out = output.data();
+    quint32 position = 0;
+
+    while(offset < encoded.size()) {
+      quint32 zeros, literal;
+      if(!ReadVarInt(encoded, offset, zeros) ||
+          !ReadVarInt(encoded, offset, literal))
+      {
+        return false;
+      }
+
+      if(zeros > size - position) {
+        return false;
+      }
+      position += zeros;
+
+      if(literal > size - position ||
+          literal > quint32(encoded.size() - offset))
+      {
+        return false;
+      }
+      memcpy(out + position, encoded.constData() + offset, literal);
+      position += literal;
+      offset += literal;
+    }
+
+    if(position != size) {
+      return false;
+    }
+
+    decoded = output;
+    return true;
+  }
+}
+}
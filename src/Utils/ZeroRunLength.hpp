@@ -0,0 +1,51 @@
+#ifndef DISSENT_UTILS_ZERO_RUN_LENGTH_H_GUARD
+#define DISSENT_UTILS_ZERO_RUN_LENGTH_H_GUARD
+
+#include <QByteArray>
+
+namespace Dissent {
+namespace Utils {
+  /**
+   * Compresses sparse byte arrays by run-length encoding their zero regions,
+   * such as the unused space in DC-net cleartexts.  The encoding is the
+   * decoded length followed by (zero run, literal length, literal bytes)
+   * tuples, with all lengths as variable length integers.  Short zero runs
+   * are kept inside literals, so dense data grows by only a few bytes.
+   */
+  class ZeroRunLength {
+    public:
+      /**
+       * Encodes data
+       * @param data the data to encode
+       */
+      static QByteArray Encode(const QByteArray &data);
+
+      /**
+       * Decodes data, returns false if encoded is malformed or would decode
+       * to more than max_size bytes
+       * @param encoded the encoded data
+       * @param decoded the resulting data
+       * @param max_size the largest acceptable decoded size
+       */
+      static bool Decode(const QByteArray &encoded, QByteArray &decoded,
+          int max_size);
+
+      /**
+       * Zero runs shorter than this remain in literals
+       */
+      static const int MIN_RUN = 4;
+
+    private:
+      static void WriteVarInt(quint32 value, QByteArray &data);
+      static bool ReadVarInt(const QByteArray &data, int &offset,
+          quint32 &value);
+
+      /**
+       * No instances of this class
+       */
+      ZeroRunLength() {}
+  };
+}
+}
+
+#endif
@@ -72,6 +72,7 @@ SOURCES += ext/googletest/src/gtest-all.cc \
            src/Tests/OnionTest.cpp \
            src/Tests/OverlayHelper.cpp \
            src/Tests/PackagersTest.cpp \
+           src/Tests/PadGeneratorTest.cpp \
            src/Tests/PacketsTest.cpp \
            src/Tests/PeerReviewTest.cpp \
            src/Tests/RandomTest.cpp \
@@ -81,6 +82,9 @@ SOURCES += ext/googletest/src/gtest-all.cc \
            src/Tests/SerializationTest.cpp \
            src/Tests/SettingsTest.cpp \
            src/Tests/ShuffleRoundTest.cpp \
+           src/Tests/SlotRandomizerTest.cpp \
+           src/Tests/SubmissionDeadlineTest.cpp \
+           src/Tests/TaskSchedulerTest.cpp \
            src/Tests/TcpTest.cpp \
            src/Tests/TestNode.cpp \
            src/Tests/TestWebClient.cpp \
@@ -89,4 +93,6 @@ SOURCES += ext/googletest/src/gtest-all.cc \
            src/Tests/TripleTest.cpp \
            src/Tests/WebServerTest.cpp \
            src/Tests/WebServicesTest.cpp \
+           src/Tests/XorKernelTest.cpp \
+           src/Tests/ZeroRunLengthTest.cpp \
 	   src/Tests/AuthenticateTest.cpp